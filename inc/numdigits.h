@@ -4,68 +4,256 @@
 // Easiest:  numdigits_dumb_sprintf_strlen( int x );
 // Simplest: numdigits10_uint32( uint32_t n )
 
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Exit profile: which early return of a ladder do real inputs take?
+//     g++ -DNUMDIGITS_PROFILE ...                      // instrument NUMDIGITS_EXIT() below
+//     NUMDIGITS_PROFILE_FILE=exits.txt ./your_app      // default: numdigits_profile.txt, written at exit
+//     numdigits_benchmark -profile=exits.txt           // benchmark on the profiled digit lengths
+// Instrumented: numdigits10_uint32(), numdigits10_uint64(), numdigits10_reverse_uint32/64(), digits10_pohoreski_v1/v2/v3()
+// Without NUMDIGITS_PROFILE the macros are a plain return. With it each return counts into a per-thread
+// table (no atomics on the hot path) which is merged when the thread exits.
+// The profile has two kinds of lines:
+//     exit   <function> <line> <digits> <hits>   // one per return statement and result
+//     length <function> <digits> <calls>         // what the function returned to its caller
+// A recursive return also passes through an inner exit; the length lines don't count that twice.
+#ifdef NUMDIGITS_PROFILE
+    #include <algorithm> // std::find_if()
+    #include <mutex>
+    #include <stdio.h>
+    #include <stdlib.h> // getenv()
+    #include <string.h> // strcmp()
+    #include <vector>
+
+    #define NUMDIGITS_PROFILE_DIGITS 21 // 0 .. 20
+
+    struct NumDigitsExitSite
+    {
+        const char *pFunc;
+        int         nLine;
+        uint32_t    nRecurse; // a recursive return adds this many digits to an inner exit, else 0
+        size_t      iSite;
+
+        NumDigitsExitSite( const char *func, int line, uint32_t recurse );
+    };
+
+    struct NumDigitsProfile
+    {
+        std::mutex                             Lock;
+        std::vector<const NumDigitsExitSite*>  Sites;
+        std::vector<uint64_t>                  Hits; // [ iSite*NUMDIGITS_PROFILE_DIGITS + digits ] of exited threads
+
+        void Lengths( const char *pFunc, uint64_t (&aCalls)[ NUMDIGITS_PROFILE_DIGITS ] ) const;
+       ~NumDigitsProfile();
+    };
+
+    NumDigitsProfile& numdigits_profile()
+    {
+        static NumDigitsProfile profile;
+        return profile;
+    }
+
+    NumDigitsExitSite::NumDigitsExitSite( const char *func, int line, uint32_t recurse )
+        : pFunc( func ), nLine( line ), nRecurse( recurse )
+    {
+        NumDigitsProfile& profile = numdigits_profile();
+        std::lock_guard<std::mutex> lock( profile.Lock );
+        iSite = profile.Sites.size();
+        profile.Sites.push_back( this );
+    }
+
+    struct NumDigitsProfileThread
+    {
+        std::vector<uint64_t> Hits;
+
+        ~NumDigitsProfileThread();
+    };
+
+    static thread_local NumDigitsProfileThread t_NumDigitsProfile;
+
+    void numdigits_profile_hit( const NumDigitsExitSite& site, uint32_t digits )
+    {
+        const size_t i = site.iSite*NUMDIGITS_PROFILE_DIGITS + digits;
+        std::vector<uint64_t>& hits = t_NumDigitsProfile.Hits;
+        if (hits.size() <= i)
+            hits.resize( (site.iSite + 1)*NUMDIGITS_PROFILE_DIGITS );
+        hits[ i ]++;
+    }
+
+    // Merge this thread's counts, e.g. before numdigits_profile_lengths() in a long running process
+    void numdigits_profile_flush()
+    {
+        NumDigitsProfile&      profile = numdigits_profile();
+        std::vector<uint64_t>& hits    = t_NumDigitsProfile.Hits;
+
+        std::lock_guard<std::mutex> lock( profile.Lock );
+        if (profile.Hits.size() < hits.size())
+            profile.Hits.resize( hits.size() );
+        for (size_t i = 0; i < hits.size(); i++)
+            profile.Hits[ i ] += hits[ i ];
+        hits.clear();
+    }
+
+    NumDigitsProfileThread::~NumDigitsProfileThread()
+    {
+        numdigits_profile_flush();
+    }
+
+    // Returned lengths of one function (all when pFunc is null)
+    void NumDigitsProfile::Lengths( const char *pFunc, uint64_t (&aCalls)[ NUMDIGITS_PROFILE_DIGITS ] ) const
+    {
+        for (uint64_t& calls : aCalls)
+            calls = 0;
+
+        for (size_t i = 0; i < Hits.size(); i++)
+        {
+            const NumDigitsExitSite *pSite  = Sites[ i / NUMDIGITS_PROFILE_DIGITS ];
+            const uint32_t           digits = i % NUMDIGITS_PROFILE_DIGITS;
+            if (pFunc && strcmp( pFunc, pSite->pFunc ))
+                continue;
+
+            if (!Hits[ i ])
+                continue;
+
+            aCalls[ digits ] += Hits[ i ];
+            if (pSite->nRecurse) // the inner call already counted digits - nRecurse
+                aCalls[ digits - pSite->nRecurse ] -= Hits[ i ];
+        }
+    }
+
+    // Merged counts only, call numdigits_profile_flush() first for the current thread
+    void numdigits_profile_lengths( const char *pFunc, uint64_t (&aCalls)[ NUMDIGITS_PROFILE_DIGITS ] )
+    {
+        NumDigitsProfile& profile = numdigits_profile();
+        std::lock_guard<std::mutex> lock( profile.Lock );
+        profile.Lengths( pFunc, aCalls );
+    }
+
+    NumDigitsProfile::~NumDigitsProfile()
+    {
+        // Every thread_local, including the main thread's, is destroyed before statics so all threads are merged
+        if (Hits.empty())
+            return;
+
+        const char *pFileName = getenv( "NUMDIGITS_PROFILE_FILE" );
+        FILE       *pFile     = fopen( pFileName ? pFileName : "numdigits_profile.txt", "w" );
+        if (!pFile)
+            return;
+
+        fprintf( pFile, "# numdigits exit profile\n" );
+        fprintf( pFile, "# exit   <function> <line> <digits> <hits>\n" );
+        for (size_t i = 0; i < Hits.size(); i++)
+        {
+            const NumDigitsExitSite *pSite = Sites[ i / NUMDIGITS_PROFILE_DIGITS ];
+            if (Hits[ i ])
+                fprintf( pFile, "exit %s %d %u %llu\n", pSite->pFunc, pSite->nLine, (uint32_t)(i % NUMDIGITS_PROFILE_DIGITS), (unsigned long long) Hits[ i ] );
+        }
+
+        fprintf( pFile, "# length <function> <digits> <calls>\n" );
+        std::vector<const char*> aFuncs;
+        for (const NumDigitsExitSite *pSite : Sites)
+        {
+            if (std::find_if( aFuncs.begin(), aFuncs.end(), [=]( const char *p ) { return strcmp( p, pSite->pFunc ) == 0; } ) != aFuncs.end())
+                continue;
+            aFuncs.push_back( pSite->pFunc );
+
+            uint64_t aCalls[ NUMDIGITS_PROFILE_DIGITS ];
+            Lengths( pSite->pFunc, aCalls );
+            for (uint32_t digits = 0; digits < NUMDIGITS_PROFILE_DIGITS; digits++)
+                if (aCalls[ digits ])
+                    fprintf( pFile, "length %s %u %llu\n", pSite->pFunc, digits, (unsigned long long) aCalls[ digits ] );
+        }
+        fclose( pFile );
+    }
+
+    #define NUMDIGITS_EXIT_SITE( recurse, digits ) do {                               \
+        static const NumDigitsExitSite numdigits_site_( __func__, __LINE__, recurse ); \
+        const uint32_t numdigits_digits_ = (digits);                                  \
+        numdigits_profile_hit( numdigits_site_, numdigits_digits_ );                  \
+        return numdigits_digits_; } while (0)
+
+    #define NUMDIGITS_EXIT( digits )                NUMDIGITS_EXIT_SITE( 0, digits )
+    #define NUMDIGITS_EXIT_RECURSE( digits, call )  NUMDIGITS_EXIT_SITE( digits, (digits) + (call) )
+#else
+    #define NUMDIGITS_EXIT( digits )                return digits
+    #define NUMDIGITS_EXIT_RECURSE( digits, call )  return (digits) + (call)
+#endif
+
 // Reference uint32_t
 uint32_t numdigits10_uint32( uint32_t n )
 {
-    if (n <            10) return  1;
-    if (n <           100) return  2;
-    if (n <         1'000) return  3;
-    if (n <        10'000) return  4;
-    if (n <       100'000) return  5;
-    if (n <     1'000'000) return  6;
-    if (n <    10'000'000) return  7;
-    if (n <   100'000'000) return  8;
-    if (n < 1'000'000'000) return  9;
-    /*else<=4'294'967'295*/return 10; // 2^32 - 1
+    if (n <            10) NUMDIGITS_EXIT(  1 );
+    if (n <           100) NUMDIGITS_EXIT(  2 );
+    if (n <         1'000) NUMDIGITS_EXIT(  3 );
+    if (n <        10'000) NUMDIGITS_EXIT(  4 );
+    if (n <       100'000) NUMDIGITS_EXIT(  5 );
+    if (n <     1'000'000) NUMDIGITS_EXIT(  6 );
+    if (n <    10'000'000) NUMDIGITS_EXIT(  7 );
+    if (n <   100'000'000) NUMDIGITS_EXIT(  8 );
+    if (n < 1'000'000'000) NUMDIGITS_EXIT(  9 );
+    /*else<=4'294'967'295*/NUMDIGITS_EXIT( 10 ); // 2^32 - 1
 }
 
 // Reference uint64_t
 uint32_t numdigits10_uint64( uint64_t n )
 {
-    if (n <                         10ull) return  1;
-    if (n <                        100ull) return  2;
-    if (n <                      1'000ull) return  3;
-    if (n <                     10'000ull) return  4;
-    if (n <                    100'000ull) return  5;
-    if (n <                  1'000'000ull) return  6;
-    if (n <                 10'000'000ull) return  7;
-    if (n <                100'000'000ull) return  8;
-    if (n <              1'000'000'000ull) return  9;
-    if (n <             10'000'000'000ull) return 10;
-    if (n <            100'000'000'000ull) return 11;
-    if (n <          1'000'000'000'000ull) return 12;
-    if (n <         10'000'000'000'000ull) return 13;
-    if (n <        100'000'000'000'000ull) return 14;
-    if (n <      1'000'000'000'000'000ull) return 15;
-    if (n <     10'000'000'000'000'000ull) return 16;
-    if (n <    100'000'000'000'000'000ull) return 17;
-    if (n <  1'000'000'000'000'000'000ull) return 18;
-    if (n < 10'000'000'000'000'000'000ull) return 19;
-    /*else<=18'446'744'073'709'551'615*/   return 20; // 2^64 - 1
+    if (n <                         10ull) NUMDIGITS_EXIT(  1 );
+    if (n <                        100ull) NUMDIGITS_EXIT(  2 );
+    if (n <                      1'000ull) NUMDIGITS_EXIT(  3 );
+    if (n <                     10'000ull) NUMDIGITS_EXIT(  4 );
+    if (n <                    100'000ull) NUMDIGITS_EXIT(  5 );
+    if (n <                  1'000'000ull) NUMDIGITS_EXIT(  6 );
+    if (n <                 10'000'000ull) NUMDIGITS_EXIT(  7 );
+    if (n <                100'000'000ull) NUMDIGITS_EXIT(  8 );
+    if (n <              1'000'000'000ull) NUMDIGITS_EXIT(  9 );
+    if (n <             10'000'000'000ull) NUMDIGITS_EXIT( 10 );
+    if (n <            100'000'000'000ull) NUMDIGITS_EXIT( 11 );
+    if (n <          1'000'000'000'000ull) NUMDIGITS_EXIT( 12 );
+    if (n <         10'000'000'000'000ull) NUMDIGITS_EXIT( 13 );
+    if (n <        100'000'000'000'000ull) NUMDIGITS_EXIT( 14 );
+    if (n <      1'000'000'000'000'000ull) NUMDIGITS_EXIT( 15 );
+    if (n <     10'000'000'000'000'000ull) NUMDIGITS_EXIT( 16 );
+    if (n <    100'000'000'000'000'000ull) NUMDIGITS_EXIT( 17 );
+    if (n <  1'000'000'000'000'000'000ull) NUMDIGITS_EXIT( 18 );
+    if (n < 10'000'000'000'000'000'000ull) NUMDIGITS_EXIT( 19 );
+    /*else<=18'446'744'073'709'551'615*/   NUMDIGITS_EXIT( 20 ); // 2^64 - 1
+}
+
+uint32_t numdigits10_reverse_uint32( uint32_t n )
+{
+    if (n >= 1'000'000'000) NUMDIGITS_EXIT( 10 ); // 2^32 - 1
+    if (n >=   100'000'000) NUMDIGITS_EXIT(  9 );
+    if (n >=    10'000'000) NUMDIGITS_EXIT(  8 );
+    if (n >=     1'000'000) NUMDIGITS_EXIT(  7 );
+    if (n >=       100'000) NUMDIGITS_EXIT(  6 );
+    if (n >=        10'000) NUMDIGITS_EXIT(  5 );
+    if (n >=         1'000) NUMDIGITS_EXIT(  4 );
+    if (n >=           100) NUMDIGITS_EXIT(  3 );
+    if (n >=            10) NUMDIGITS_EXIT(  2 );
+    /*else>=             0*/NUMDIGITS_EXIT(  1 );
 }
 
 uint32_t numdigits10_reverse_uint64( uint64_t n )
 {
-    if (n >= 10'000'000'000'000'000'000ull) return 20; // 2^64 - 1
-    if (n >=  1'000'000'000'000'000'000ull) return 19;
-    if (n >=    100'000'000'000'000'000ull) return 18;
-    if (n >=     10'000'000'000'000'000ull) return 17;
-    if (n >=      1'000'000'000'000'000ull) return 16;
-    if (n >=        100'000'000'000'000ull) return 15;
-    if (n >=         10'000'000'000'000ull) return 14;
-    if (n >=          1'000'000'000'000ull) return 13;
-    if (n >=            100'000'000'000ull) return 12;
-    if (n >=             10'000'000'000ull) return 11;
-    if (n >=              1'000'000'000ull) return 10;
-    if (n >=                100'000'000ull) return  9;
-    if (n >=                 10'000'000ull) return  8;
-    if (n >=                  1'000'000ull) return  7;
-    if (n >=                    100'000ull) return  6;
-    if (n >=                     10'000ull) return  5;
-    if (n >=                      1'000ull) return  4;
-    if (n >=                        100ull) return  3;
-    if (n >=                         10ull) return  2;
-    /*else>=                          0  */ return  1;
+    if (n >= 10'000'000'000'000'000'000ull) NUMDIGITS_EXIT( 20 ); // 2^64 - 1
+    if (n >=  1'000'000'000'000'000'000ull) NUMDIGITS_EXIT( 19 );
+    if (n >=    100'000'000'000'000'000ull) NUMDIGITS_EXIT( 18 );
+    if (n >=     10'000'000'000'000'000ull) NUMDIGITS_EXIT( 17 );
+    if (n >=      1'000'000'000'000'000ull) NUMDIGITS_EXIT( 16 );
+    if (n >=        100'000'000'000'000ull) NUMDIGITS_EXIT( 15 );
+    if (n >=         10'000'000'000'000ull) NUMDIGITS_EXIT( 14 );
+    if (n >=          1'000'000'000'000ull) NUMDIGITS_EXIT( 13 );
+    if (n >=            100'000'000'000ull) NUMDIGITS_EXIT( 12 );
+    if (n >=             10'000'000'000ull) NUMDIGITS_EXIT( 11 );
+    if (n >=              1'000'000'000ull) NUMDIGITS_EXIT( 10 );
+    if (n >=                100'000'000ull) NUMDIGITS_EXIT(  9 );
+    if (n >=                 10'000'000ull) NUMDIGITS_EXIT(  8 );
+    if (n >=                  1'000'000ull) NUMDIGITS_EXIT(  7 );
+    if (n >=                    100'000ull) NUMDIGITS_EXIT(  6 );
+    if (n >=                     10'000ull) NUMDIGITS_EXIT(  5 );
+    if (n >=                      1'000ull) NUMDIGITS_EXIT(  4 );
+    if (n >=                        100ull) NUMDIGITS_EXIT(  3 );
+    if (n >=                         10ull) NUMDIGITS_EXIT(  2 );
+    /*else>=                          0  */ NUMDIGITS_EXIT(  1 );
 }
 
 // Reference int using standard powers of 10 and zero
@@ -535,6 +723,174 @@ int numdigits_log(int n)
     return negative + (int)(digits) + 1;
 }
 
+// Count leading zeros + lookup table
+// The bit width of n gives us the number of digits of the smallest number with that width:
+//     2^(bits-1) <= n < 2^bits
+// Since a bit width spans less than one power of 10 the estimate is either exact or one short
+// so a single compare against Pow10_u64[] fixes it up. No loops, no branches.
+#if _MSC_VER
+    #include <intrin.h> // _BitScanReverse() _BitScanReverse64()
+#endif
+
+// Returns 1 .. 32; zero is treated as 1 since both have 1 digit
+inline uint32_t bitwidth_u32( uint32_t n )
+{
+#if _MSC_VER
+    unsigned long index;
+    _BitScanReverse( &index, n | 1 );
+    return (uint32_t)index + 1;
+#else
+    return 32 - (uint32_t)__builtin_clz( n | 1 );
+#endif
+}
+
+// Returns 1 .. 64; zero is treated as 1 since both have 1 digit
+inline uint32_t bitwidth_u64( uint64_t n )
+{
+#if _MSC_VER
+    unsigned long index;
+    _BitScanReverse64( &index, n | 1 );
+    return (uint32_t)index + 1;
+#else
+    return 64 - (uint32_t)__builtin_clzll( n | 1 );
+#endif
+}
+
+// Minimum number of digits for a given bit width = digits( 2^(bits-1) )
+const uint8_t Digits10_BitWidth[65] =
+{
+           1 // [ 0] 0 (n | 1 never gives zero bits)
+        ,  1 // [ 1] 2^0  .. 2^1  - 1
+        ,  1 // [ 2] 2^1  .. 2^2  - 1
+        ,  1 // [ 3] 2^2  .. 2^3  - 1
+        ,  1 // [ 4] 2^3  .. 2^4  - 1
+        ,  2 // [ 5] 2^4  .. 2^5  - 1
+        ,  2 // [ 6] 2^5  .. 2^6  - 1
+        ,  2 // [ 7] 2^6  .. 2^7  - 1
+        ,  3 // [ 8] 2^7  .. 2^8  - 1
+        ,  3 // [ 9] 2^8  .. 2^9  - 1
+        ,  3 // [10] 2^9  .. 2^10 - 1
+        ,  4 // [11] 2^10 .. 2^11 - 1
+        ,  4 // [12] 2^11 .. 2^12 - 1
+        ,  4 // [13] 2^12 .. 2^13 - 1
+        ,  4 // [14] 2^13 .. 2^14 - 1
+        ,  5 // [15] 2^14 .. 2^15 - 1
+        ,  5 // [16] 2^15 .. 2^16 - 1
+        ,  5 // [17] 2^16 .. 2^17 - 1
+        ,  6 // [18] 2^17 .. 2^18 - 1
+        ,  6 // [19] 2^18 .. 2^19 - 1
+        ,  6 // [20] 2^19 .. 2^20 - 1
+        ,  7 // [21] 2^20 .. 2^21 - 1
+        ,  7 // [22] 2^21 .. 2^22 - 1
+        ,  7 // [23] 2^22 .. 2^23 - 1
+        ,  7 // [24] 2^23 .. 2^24 - 1
+        ,  8 // [25] 2^24 .. 2^25 - 1
+        ,  8 // [26] 2^25 .. 2^26 - 1
+        ,  8 // [27] 2^26 .. 2^27 - 1
+        ,  9 // [28] 2^27 .. 2^28 - 1
+        ,  9 // [29] 2^28 .. 2^29 - 1
+        ,  9 // [30] 2^29 .. 2^30 - 1
+        , 10 // [31] 2^30 .. 2^31 - 1
+        , 10 // [32] 2^31 .. 2^32 - 1
+        , 10 // [33] 2^32 .. 2^33 - 1
+        , 10 // [34] 2^33 .. 2^34 - 1
+        , 11 // [35] 2^34 .. 2^35 - 1
+        , 11 // [36] 2^35 .. 2^36 - 1
+        , 11 // [37] 2^36 .. 2^37 - 1
+        , 12 // [38] 2^37 .. 2^38 - 1
+        , 12 // [39] 2^38 .. 2^39 - 1
+        , 12 // [40] 2^39 .. 2^40 - 1
+        , 13 // [41] 2^40 .. 2^41 - 1
+        , 13 // [42] 2^41 .. 2^42 - 1
+        , 13 // [43] 2^42 .. 2^43 - 1
+        , 13 // [44] 2^43 .. 2^44 - 1
+        , 14 // [45] 2^44 .. 2^45 - 1
+        , 14 // [46] 2^45 .. 2^46 - 1
+        , 14 // [47] 2^46 .. 2^47 - 1
+        , 15 // [48] 2^47 .. 2^48 - 1
+        , 15 // [49] 2^48 .. 2^49 - 1
+        , 15 // [50] 2^49 .. 2^50 - 1
+        , 16 // [51] 2^50 .. 2^51 - 1
+        , 16 // [52] 2^51 .. 2^52 - 1
+        , 16 // [53] 2^52 .. 2^53 - 1
+        , 16 // [54] 2^53 .. 2^54 - 1
+        , 17 // [55] 2^54 .. 2^55 - 1
+        , 17 // [56] 2^55 .. 2^56 - 1
+        , 17 // [57] 2^56 .. 2^57 - 1
+        , 18 // [58] 2^57 .. 2^58 - 1
+        , 18 // [59] 2^58 .. 2^59 - 1
+        , 18 // [60] 2^59 .. 2^60 - 1
+        , 19 // [61] 2^60 .. 2^61 - 1
+        , 19 // [62] 2^61 .. 2^62 - 1
+        , 19 // [63] 2^62 .. 2^63 - 1
+        , 19 // [64] 2^63 .. 2^64 - 1
+};
+
+uint32_t digits10_lzcnt_u32( uint32_t n )
+{
+    const uint32_t digits = Digits10_BitWidth[ bitwidth_u32( n ) ];
+    return digits + (n >= Pow10_u64[ digits - 1 ]);
+}
+
+uint32_t digits10_lzcnt( uint64_t n )
+{
+    const uint32_t digits = Digits10_BitWidth[ bitwidth_u64( n ) ];
+    return digits + (n >= Pow10_u64[ digits - 1 ]);
+}
+
+int numdigits_lzcnt( int n )
+{
+    const uint32_t x = (n < 0) ? 0u - (uint32_t)n : (uint32_t)n; // defined for INT_MIN; the abs() version gave 12 for it once inlined with g++ 12.2 -O2
+    return (n < 0) + digits10_lzcnt_u32( x );
+}
+
+int32_t numdigits_lzcnt_int64( int64_t n )
+{
+    const uint64_t x = (n < 0) ? 0 - (uint64_t)n : (uint64_t)n; // handles INT64_MIN
+    return (n < 0) + digits10_lzcnt( x );
+}
+
+// IEEE exponent: the int -> float conversion unit computes log2() for us.
+// Same estimate and fix-up as digits10_lzcnt() but the bit width comes from the exponent bits
+// of (float)n, or (double)n for 64-bit, instead of counting leading zeros. Digits10_BitWidth[ log2 + 1 ]
+// is the 64 entry table of digits( 2^log2 ).
+// The conversion rounds to nearest so n just below a power of 2 can become that power of 2, one bit wider.
+// That is harmless: no power of 10 is that close below a power of 2, so the estimate has the same digits
+// and the compare stays false. The same trick vectorizes, see numdigits_batch_fpexp_avx2().
+#include <string.h> // memcpy()
+
+uint32_t digits10_fpexp_u32( uint32_t n )
+{
+    const float f = (float)(n | 1);
+    uint32_t    bits;
+    memcpy( &bits, &f, sizeof(bits) );
+    const uint32_t digits = Digits10_BitWidth[ (bits >> 23) - 127 + 1 ]; // log2 0 .. 32
+    return digits + (n >= Pow10_u64[ digits - 1 ]);
+}
+
+// log2 is 64 when n rounds up to 2^64, which has the 19 + 1 digits of 2^63 after the compare
+uint32_t digits10_fpexp( uint64_t n )
+{
+    const double d = (double)(n | 1);
+    uint64_t     bits;
+    memcpy( &bits, &d, sizeof(bits) );
+    const uint32_t log2   = (uint32_t)(bits >> 52) - 1023; // 0 .. 64
+    const uint32_t digits = Digits10_BitWidth[ log2 + 1 - (log2 >> 6) ];
+    return digits + (n >= Pow10_u64[ digits - 1 ]);
+}
+
+int numdigits_fpexp( int n )
+{
+    const uint32_t x = (n < 0) ? 0u - (uint32_t)n : (uint32_t)n; // handles INT_MIN
+    return (n < 0) + (int)digits10_fpexp_u32( x );
+}
+
+int32_t numdigits_fpexp_int64( int64_t n )
+{
+    const uint64_t x = (n < 0) ? 0 - (uint64_t)n : (uint64_t)n; // handles INT64_MIN
+    return (n < 0) + digits10_fpexp( x );
+}
+
 #include <string>
 // Only really for testing of how slow _itoa() is!
 int32_t numdigits_microsoft_itoa_strlen( int n )
@@ -554,24 +910,24 @@ int32_t numdigits_microsoft_itoa_strlen( int n )
 uint32_t digits10_pohoreski_v1( uint64_t n )
 {
     if (n < P04) {
-        if (n < P01) return 1;
-        if (n < P02) return 2;
-        if (n < P03) return 3;
-        /*    <P 04*/return 4;
+        if (n < P01) NUMDIGITS_EXIT( 1 );
+        if (n < P02) NUMDIGITS_EXIT( 2 );
+        if (n < P03) NUMDIGITS_EXIT( 3 );
+        /*    <P 04*/NUMDIGITS_EXIT( 4 );
     }
     if (n < P08) {
-        if (n < P05) return 5;
-        if (n < P06) return 6;
-        if (n < P07) return 7;
-        /*    < P08*/return 8;
+        if (n < P05) NUMDIGITS_EXIT( 5 );
+        if (n < P06) NUMDIGITS_EXIT( 6 );
+        if (n < P07) NUMDIGITS_EXIT( 7 );
+        /*    < P08*/NUMDIGITS_EXIT( 8 );
     }
     if (n < P12) {
-        if (n < P09) return  9;
-        if (n < P10) return 10;
-        if (n < P11) return 11;
-        /*    < P12*/return 12;
+        if (n < P09) NUMDIGITS_EXIT(  9 );
+        if (n < P10) NUMDIGITS_EXIT( 10 );
+        if (n < P11) NUMDIGITS_EXIT( 11 );
+        /*    < P12*/NUMDIGITS_EXIT( 12 );
     }
-    return 12 + digits10_pohoreski_v1(n / P12);
+    NUMDIGITS_EXIT_RECURSE( 12, digits10_pohoreski_v1(n / P12) );
 }
 
 int numdigits_pohoreski_v1a(int n )
@@ -591,23 +947,23 @@ uint32_t digits10_pohoreski_v2( uint64_t n )
 {
     if (n < P08) {
         if (n < P04) {
-            if (n < P01) return 1;
-            if (n < P02) return 2;
-            if (n < P03) return 3;
-            /*  n < P04*/return 4;
+            if (n < P01) NUMDIGITS_EXIT( 1 );
+            if (n < P02) NUMDIGITS_EXIT( 2 );
+            if (n < P03) NUMDIGITS_EXIT( 3 );
+            /*  n < P04*/NUMDIGITS_EXIT( 4 );
         }
-        if (n < P05) return 5;
-        if (n < P06) return 6;
-        if (n < P07) return 7;
-        /*  n < P08*/return 8;
+        if (n < P05) NUMDIGITS_EXIT( 5 );
+        if (n < P06) NUMDIGITS_EXIT( 6 );
+        if (n < P07) NUMDIGITS_EXIT( 7 );
+        /*  n < P08*/NUMDIGITS_EXIT( 8 );
     }
     if (n < P12) {
-        if (n < P09) return  9;
-        if (n < P10) return 10;
-        if (n < P11) return 11;
-        /*  n < P12*/return 12;
+        if (n < P09) NUMDIGITS_EXIT(  9 );
+        if (n < P10) NUMDIGITS_EXIT( 10 );
+        if (n < P11) NUMDIGITS_EXIT( 11 );
+        /*  n < P12*/NUMDIGITS_EXIT( 12 );
     }
-    return 12 + digits10_pohoreski_v2(n / P12);
+    NUMDIGITS_EXIT_RECURSE( 12, digits10_pohoreski_v2(n / P12) );
 }
 
 int numdigits_pohoreski_v2a( int n )
@@ -625,16 +981,16 @@ int numdigits_pohoreski_v2b( int n )
 
 uint32_t digits10_pohoreski_v3( uint32_t n )
 {
-    if (n <            10) return  1;
-    if (n <           100) return  2;
-    if (n <         1'000) return  3;
-    if (n <        10'000) return  4;
-    if (n <       100'000) return  5;
-    if (n <     1'000'000) return  6;
-    if (n <    10'000'000) return  7;
-    if (n <   100'000'000) return  8;
-    if (n < 1'000'000'000) return  9;
-    /*  n <=2'147'483'647*/return 10;
+    if (n <            10) NUMDIGITS_EXIT(  1 );
+    if (n <           100) NUMDIGITS_EXIT(  2 );
+    if (n <         1'000) NUMDIGITS_EXIT(  3 );
+    if (n <        10'000) NUMDIGITS_EXIT(  4 );
+    if (n <       100'000) NUMDIGITS_EXIT(  5 );
+    if (n <     1'000'000) NUMDIGITS_EXIT(  6 );
+    if (n <    10'000'000) NUMDIGITS_EXIT(  7 );
+    if (n <   100'000'000) NUMDIGITS_EXIT(  8 );
+    if (n < 1'000'000'000) NUMDIGITS_EXIT(  9 );
+    /*  n <=2'147'483'647*/NUMDIGITS_EXIT( 10 );
 }
 
 // 2nd fastest
@@ -710,6 +1066,11 @@ int numdigits_simple_reverse_int64(int64_t n)
 int numdigits_simple_reverse(int n) {
     return numdigits_simple_reverse_int64( (int64_t) n );
 }
+int numdigits_simple_reverse32( int n )
+{
+    const uint32_t x = (n < 0) ? 0u - (uint32_t)n : (uint32_t)n;
+    return (n < 0) + (int)numdigits10_reverse_uint32( x );
+}
 
 // https://stackoverflow.com/questions/1696086/whats-the-best-way-to-get-the-length-of-the-decimal-representation-of-an-int-in
 // https://stackoverflow.com/a/1696174/1339447
@@ -859,3 +1220,2458 @@ int numdigits_vitali_template(int32_t x)
 int numdigits_vitali(int n) {
     return numdigits_vitali_template( (int32_t) n );
 }
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Generic: one constexpr numdigits<T>() for every integer width int8_t .. uint64_t
+//     constexpr int n = numdigits( -128 );                   // 4
+//     std::array<char, max_digits<int64_t>::value + 1> buf;  // 20 + NUL
+// Up to 32 bits the core is the alexandrescu_v3 comparison tree so numdigits<int>() is the same code as
+// numdigits_alexandrescu_pohoreski_v3(). A tree over 20 digits mispredicts too often on mixed magnitudes
+// so the 64-bit core is digits10_lzcnt() with the table lookup replaced by bits * log10(2).
+#include <limits>      // std::numeric_limits<>
+#include <type_traits> // std::is_integral<> std::make_unsigned<>
+#if __cplusplus >= 202002L
+    #include <bit>     // std::bit_width()
+#endif
+
+// Maximum length of the decimal string of any T including the '-', not including the NUL.
+template <typename T>
+struct max_digits
+{
+    static_assert( std::is_integral<T>::value, "max_digits<T> requires an integer type" );
+    static constexpr int value = std::numeric_limits<T>::digits10 + 1 + std::numeric_limits<T>::is_signed;
+};
+
+constexpr uint32_t digits10_constexpr_u32( uint32_t v ) noexcept
+{
+    if (v <           10) return 1;
+    if (v <          100) return 2;
+    if (v <        1'000) return 3;
+    if (v <  100'000'000) {
+        if (v < 1'000'000) {
+            if (v < 10'000) return 4;
+            return 5 + (v >= 100'000);
+        }
+        return 7 + (v >= 10'000'000);
+    }
+    return 9 + (v >= 1'000'000'000);
+}
+
+// [0] is 0 instead of 1 so that zero has 1 digit
+constexpr uint64_t Pow10_constexpr[20] =
+{
+                             0ull
+    ,                       10ull
+    ,                      100ull
+    ,                    1'000ull
+    ,                   10'000ull
+    ,                  100'000ull
+    ,                1'000'000ull
+    ,               10'000'000ull
+    ,              100'000'000ull
+    ,            1'000'000'000ull
+    ,           10'000'000'000ull
+    ,          100'000'000'000ull
+    ,        1'000'000'000'000ull
+    ,       10'000'000'000'000ull
+    ,      100'000'000'000'000ull
+    ,    1'000'000'000'000'000ull
+    ,   10'000'000'000'000'000ull
+    ,  100'000'000'000'000'000ull
+    ,1'000'000'000'000'000'000ull
+    ,10'000'000'000'000'000'000ull
+};
+
+// Returns 1 .. 64, same as bitwidth_u64() but usable at compile time
+constexpr uint32_t bitwidth_constexpr( uint64_t v ) noexcept
+{
+#if defined(__cpp_lib_bitops)
+    return (uint32_t) std::bit_width( v | 1 );
+#elif defined(__GNUC__)
+    return 64 - (uint32_t)__builtin_clzll( v | 1 );
+#else
+    uint32_t bits = 1;
+    while (v >>= 1)
+        bits++;
+    return bits;
+#endif
+}
+
+constexpr uint32_t digits10_constexpr( uint64_t v ) noexcept
+{
+    const uint32_t t = (bitwidth_constexpr( v ) * 1233) >> 12; // 1233/4096 ~= log10(2), t = digits or digits - 1
+    return t + (v >= Pow10_constexpr[ t ]);
+}
+
+template <typename T>
+constexpr int numdigits( T n ) noexcept
+{
+    static_assert( std::is_integral<T>::value, "numdigits<T> requires an integer type" );
+    typedef typename std::make_unsigned<T>::type U;
+
+    // 0 - x in the unsigned type is |n| even for the minimum value
+    const bool sign = (n < 0);
+    const U    x    = sign ? (U)(U(0) - (U)n) : (U)n;
+    if (sizeof(T) <= sizeof(uint32_t))
+        return sign + (int)digits10_constexpr_u32( (uint32_t) x );
+    else
+        return sign + (int)digits10_constexpr( (uint64_t) x );
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Radix: numdigits<Base>() for any base 2 .. 36, same '-' handling as numdigits<T>()
+//     constexpr int n = numdigits<16>( 255u );        // 2 "ff"
+//     int len = numdigits<36>( id );                  // base-36 id length
+// Drop-in for snprintf( buf, n, "%x", v ) + strlen() and std::to_chars( first, last, v, base ) - first.
+// Power of 2 bases are the bit width / log2(Base) rounded up, no table or compare.
+// Other bases are digits10_constexpr() with generated tables: the bit width picks t = digits or digits - 1
+// and one compare against Base^t fixes it up. For Base >= 3 there is at most one power of Base in [2^(b-1), 2^b).
+// Base 10 is numdigits<T>() so it keeps the comparison tree for 32-bit types.
+
+constexpr bool is_pow2_constexpr( uint32_t v ) noexcept
+{
+    return v && !(v & (v - 1));
+}
+
+template <uint32_t Base>
+struct radix_tables
+{
+    static_assert( Base >= 2 && Base <= 36, "radix_tables<Base> requires a base 2 .. 36" );
+
+    uint8_t  Digits  [ 65 ]; // [bits] = digits of 2^(bits-1), [0] unused
+    uint64_t PowLess1[ 65 ]; // [t] = Base^t - 1, saturates at UINT64_MAX so the compare can never be true
+
+    constexpr radix_tables() : Digits(), PowLess1()
+    {
+        for (uint32_t bits = 1; bits <= 64; bits++) {
+            uint64_t v = 1ull << (bits - 1);
+            uint8_t  d = 0;
+            do { v /= Base; d++; } while (v);
+            Digits[ bits ] = d;
+        }
+
+        uint64_t pow      = 1;
+        bool     overflow = false;
+        for (uint32_t t = 0; t <= 64; t++) {
+            PowLess1[ t ] = overflow ? UINT64_MAX : pow - 1;
+            if (pow > UINT64_MAX / Base)
+                overflow = true;
+            else
+                pow *= Base;
+        }
+    }
+};
+
+template <uint32_t Base>
+constexpr radix_tables<Base> Radix_Tables{};
+
+template <uint32_t Base>
+constexpr uint32_t digits_radix( uint64_t v ) noexcept
+{
+    static_assert( Base >= 2 && Base <= 36, "digits_radix<Base> requires a base 2 .. 36" );
+
+    if (Base == 10)
+        return digits10_constexpr( v );
+    else
+    if (is_pow2_constexpr( Base )) {
+        constexpr uint32_t shift = bitwidth_constexpr( Base ) - 1; // log2(Base)
+        return (bitwidth_constexpr( v ) + shift - 1) / shift;      // divide by a constant is a multiply
+    }
+    else {
+        const uint32_t t = Radix_Tables<Base>.Digits[ bitwidth_constexpr( v ) ];
+        return t + (v > Radix_Tables<Base>.PowLess1[ t ]);
+    }
+}
+
+template <uint32_t Base, typename T>
+constexpr int numdigits( T n ) noexcept
+{
+    static_assert( std::is_integral<T>::value, "numdigits<Base,T> requires an integer type" );
+    typedef typename std::make_unsigned<T>::type U;
+
+    if (Base == 10)
+        return numdigits<T>( n );
+
+    const bool sign = (n < 0);
+    const U    x    = sign ? (U)(U(0) - (U)n) : (U)n;
+    return sign + (int)digits_radix<Base>( (uint64_t) x );
+}
+
+// Reference: one divide per digit
+uint32_t digits_radix_reference( uint64_t v, uint32_t base )
+{
+    uint32_t digits = 1;
+    while (v >= base) {
+        v /= base;
+        digits++;
+    }
+    return digits;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// LUT: one load per number, for data that mostly fits in 16 bits
+//     uint32_t digits10_lut16( uint16_t n )  // 64 KB table
+//     uint32_t digits10_lut32( uint32_t n )  // 128 KB: the 16-bit table + one for the high half
+// The high half of a uint32_t only gives a range 65536 wide. Powers of 10 >= 10^5 are further apart than that,
+// so the table gives t = digits or digits - 1 and one compare against 10^t fixes it up, like digits10_constexpr().
+// These only win while the tables stay in L2. See numdigits_benchmark -lut for the warm and cold cache cost.
+
+struct digits10_lut_tables
+{
+    uint8_t Lo[ 65536 ]; // [n]  = digits of n
+    uint8_t Hi[ 65536 ]; // [hi] = digits of hi << 16, [0] unused
+
+    constexpr digits10_lut_tables() : Lo(), Hi()
+    {
+        for (uint32_t n = 0; n < 65536; n++) {
+            Lo[ n ] = (uint8_t) digits10_constexpr_u32( n       );
+            Hi[ n ] = (uint8_t) digits10_constexpr_u32( n << 16 );
+        }
+    }
+};
+
+constexpr digits10_lut_tables Digits10_LUT{};
+
+uint32_t digits10_lut16( uint16_t n )
+{
+    return Digits10_LUT.Lo[ n ];
+}
+
+uint32_t digits10_lut32( uint32_t n )
+{
+    const uint32_t hi = n >> 16;
+    if (!hi)
+        return Digits10_LUT.Lo[ n ];
+
+    const uint32_t t = Digits10_LUT.Hi[ hi ];
+    return t + (n >= Pow10_constexpr[ t ]); // 64-bit compare since 10^10 doesn't fit
+}
+
+int numdigits_lut16( int16_t n )
+{
+    const uint16_t x = (n < 0) ? (uint16_t)(0u - (uint16_t)n) : (uint16_t)n;
+    return (n < 0) + (int)digits10_lut16( x );
+}
+
+int numdigits_lut32( int n )
+{
+    const uint32_t x = (n < 0) ? 0u - (uint32_t)n : (uint32_t)n;
+    return (n < 0) + (int)digits10_lut32( x );
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Sign fold: an int wrapper is a digits10_*() core plus a way to fold the int to unsigned
+//     int len = numdigits_fold<SignFoldMask, digits10_gabriel>( n );
+// The hand-written _a/_b/_c wrappers each picked one fold per core; this is the whole cross-product.
+// The hand-written mask fold is (uint64_t)-n & 0xFFFFFFFF which negates INT_MIN as an int (undefined),
+// that is why gabriel_v1a and pohoreski_v1a/v2a/v3a are broken. SignFoldMask negates after the cast instead.
+
+struct SignFoldMask
+{
+    static constexpr const char *Name = "mask";
+
+    template <auto digits10>
+    static int numdigits( int n )
+    {
+        const uint64_t x = (n < 0) ? (0 - (uint64_t)n) & 0xFFFFFFFFU : (uint64_t)n;
+        return (n < 0) + (int)digits10( x );
+    }
+};
+
+struct SignFoldAbs64
+{
+    static constexpr const char *Name = "abs64";
+
+    template <auto digits10>
+    static int numdigits( int n )
+    {
+        const int64_t  i = n;
+        const uint64_t x = abs(i);
+        return (n < 0) + (int)digits10( x );
+    }
+};
+
+struct SignFoldIntMin
+{
+    static constexpr const char *Name = "intmin";
+
+    template <auto digits10>
+    static int numdigits( int n )
+    {
+        if (n == INT_MIN) return 11; // handle edge case: -2'147'483'648
+        const int x = abs(n);
+        return (n < 0) + (int)digits10( (uint32_t)x );
+    }
+};
+
+template <typename... SignFolds>
+struct SignFoldList {};
+
+typedef SignFoldList<SignFoldMask, SignFoldAbs64, SignFoldIntMin> NumDigitsSignFolds;
+
+// Every digits10_*() core that is correct up to 2^31, 64-bit and 32-bit cores alike
+#define NUMDIGITS_FOLD_CORES( CORE ) \
+    CORE( alexandrescu_v1 ) \
+    CORE( alexandrescu_v2 ) \
+    CORE( alexandrescu_v3 ) \
+    CORE( constexpr       ) \
+    CORE( constexpr_u32   ) \
+    CORE( dagostino       ) \
+    CORE( fpexp           ) \
+    CORE( fpexp_u32       ) \
+    CORE( gabriel         ) \
+    CORE( lut32           ) \
+    CORE( lzcnt           ) \
+    CORE( lzcnt_u32       ) \
+    CORE( pohoreski_v1    ) \
+    CORE( pohoreski_v2    ) \
+    CORE( pohoreski_v3    )
+
+template <typename SignFold, auto digits10>
+int numdigits_fold( int n )
+{
+    return SignFold::template numdigits<digits10>( n );
+}
+
+struct NumDigitsFoldDesc
+{
+    int       (*pFunc)( int );
+    std::string Name; // <core>_<fold>
+};
+
+template <auto digits10, typename... SignFolds>
+void numdigits_fold_add( std::vector<NumDigitsFoldDesc>& products, const char *pCore, SignFoldList<SignFolds...> )
+{
+    ( products.push_back( { numdigits_fold<SignFolds, digits10>, std::string( pCore ) + "_" + SignFolds::Name } ), ... );
+}
+
+// Every core with every fold, in NUMDIGITS_FOLD_CORES() order
+std::vector<NumDigitsFoldDesc> numdigits_fold_products()
+{
+    std::vector<NumDigitsFoldDesc> products;
+#define NUMDIGITS_FOLD_ADD( core ) numdigits_fold_add<digits10_##core>( products, #core, NumDigitsSignFolds() );
+    NUMDIGITS_FOLD_CORES( NUMDIGITS_FOLD_ADD )
+#undef NUMDIGITS_FOLD_ADD
+    return products;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Tree: a comparison tree generated at compile time for a digit length histogram
+//     constexpr uint32_t weights[10] = { 25, 30, 20, 15, 4, 2, 1, 1, 1, 1 }; // % of numbers with 1 .. 10 digits
+//     constexpr digits10_tree<10> tree( weights );
+//     uint32_t digits = digits10_tree_eval<tree>( n );
+// pohoreski_v1/v2 and alexandrescu_v3 are balanced by hand for one distribution. This is the optimal BST
+// (Knuth's O(n^3) DP over the split points) where a compare costs the chance of reaching it
+// plus a mispredict penalty times the chance of taking the less likely side, i.e. the best static prediction.
+// Every length gets weight + 1 so lengths that never show up still get a sane depth.
+// digits10_tree_eval<>() expands into nested ifs, there is no tree walk at run time.
+
+#ifndef NUMDIGITS_TREE_MISPREDICT
+#define NUMDIGITS_TREE_MISPREDICT 8 // compares per mispredict
+#endif
+
+template <size_t N>
+struct digits10_tree
+{
+    static_assert( N >= 1 && N <= 20, "digits10_tree<N> requires 1 .. 20 digit lengths" );
+
+    struct Node
+    {
+        bool    Leaf;
+        uint8_t Digits; // leaf: the length, else: go Left when n < 10^Digits
+        uint8_t Left;
+        uint8_t Right;
+    };
+
+    Node     Nodes[ 2*N - 1 ];
+    uint8_t  Root;
+    uint64_t Cost; // expected cost times the weight total
+
+    constexpr digits10_tree( const uint32_t (&aWeights)[ N ], uint32_t mispredict = NUMDIGITS_TREE_MISPREDICT )
+        : Nodes(), Root( 0 ), Cost( 0 )
+    {
+        uint64_t aPrefix[ N + 1 ] = {};
+        for (size_t i = 0; i < N; i++)
+            aPrefix[ i + 1 ] = aPrefix[ i ] + aWeights[ i ] + 1;
+
+        uint64_t aCost [ N ][ N ] = {}; // [i][j] = best subtree over lengths i+1 .. j+1
+        uint8_t  aSplit[ N ][ N ] = {}; // [i][j] = k, left subtree is i .. k
+        for (size_t len = 2; len <= N; len++) {
+            for (size_t i = 0; i + len <= N; i++) {
+                const size_t j = i + len - 1;
+                aCost[ i ][ j ] = UINT64_MAX;
+                for (size_t k = i; k < j; k++) {
+                    const uint64_t left  = aPrefix[ k + 1 ] - aPrefix[ i     ];
+                    const uint64_t right = aPrefix[ j + 1 ] - aPrefix[ k + 1 ];
+                    const uint64_t cost  = (left + right) + mispredict * (left < right ? left : right)
+                                         + aCost[ i ][ k ] + aCost[ k + 1 ][ j ];
+                    if (cost < aCost[ i ][ j ]) {
+                        aCost [ i ][ j ] = cost;
+                        aSplit[ i ][ j ] = (uint8_t) k;
+                    }
+                }
+            }
+        }
+
+        size_t nNodes = 0;
+        Root = build( aSplit, 0, N - 1, nNodes );
+        Cost = aCost[ 0 ][ N - 1 ];
+    }
+
+    constexpr uint8_t build( const uint8_t (&aSplit)[ N ][ N ], size_t i, size_t j, size_t& nNodes )
+    {
+        const uint8_t iNode = (uint8_t) nNodes++;
+        if (i == j) {
+            Nodes[ iNode ] = { true, (uint8_t)(i + 1), 0, 0 };
+        } else {
+            const size_t  k     = aSplit[ i ][ j ];
+            const uint8_t left  = build( aSplit, i    , k, nNodes );
+            const uint8_t right = build( aSplit, k + 1, j, nNodes );
+            Nodes[ iNode ] = { false, (uint8_t)(k + 1), left, right };
+        }
+        return iNode;
+    }
+};
+
+template <const auto& Tree, size_t iNode = Tree.Root>
+constexpr uint32_t digits10_tree_eval( uint64_t n ) noexcept
+{
+    constexpr auto node = Tree.Nodes[ iNode ];
+    if constexpr (node.Leaf)
+        return node.Digits;
+    else
+    if (n < Pow10_constexpr[ node.Digits ])
+        return digits10_tree_eval<Tree, node.Left >( n );
+    else
+        return digits10_tree_eval<Tree, node.Right>( n );
+}
+
+// Uniform uint32_t: how many of the 2^32 numbers have 1 .. 10 digits
+constexpr uint32_t Digits10_Weights_Uniform32[ 10 ] =
+{
+    10, 90, 900, 9'000, 90'000, 900'000, 9'000'000, 90'000'000, 900'000'000, 3'294'967'296
+};
+
+// Mostly small: counters, ids, ports, percentages. Most numbers have 1 .. 4 digits
+constexpr uint32_t Digits10_Weights_Small32[ 10 ] =
+{
+    25, 30, 20, 15, 4, 2, 1, 1, 1, 1
+};
+
+constexpr uint32_t Digits10_Weights_Small64[ 20 ] =
+{
+    25, 30, 20, 15, 4, 2, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1
+};
+
+constexpr digits10_tree<10> Digits10_Tree_Uniform32( Digits10_Weights_Uniform32 );
+constexpr digits10_tree<10> Digits10_Tree_Small32  ( Digits10_Weights_Small32   );
+constexpr digits10_tree<20> Digits10_Tree_Small64  ( Digits10_Weights_Small64   );
+
+uint32_t digits10_tree_uniform32( uint32_t n )
+{
+    return digits10_tree_eval<Digits10_Tree_Uniform32>( n );
+}
+
+uint32_t digits10_tree_small32( uint32_t n )
+{
+    return digits10_tree_eval<Digits10_Tree_Small32>( n );
+}
+
+uint32_t digits10_tree_small64( uint64_t n )
+{
+    return digits10_tree_eval<Digits10_Tree_Small64>( n );
+}
+
+int numdigits_tree_uniform32( int n )
+{
+    const uint32_t x = (n < 0) ? 0u - (uint32_t)n : (uint32_t)n;
+    return (n < 0) + (int)digits10_tree_uniform32( x );
+}
+
+int numdigits_tree_small32( int n )
+{
+    const uint32_t x = (n < 0) ? 0u - (uint32_t)n : (uint32_t)n;
+    return (n < 0) + (int)digits10_tree_small32( x );
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// 128-bit: unsigned __int128 up to 39 digits, __int128 up to 40 with the '-'
+// GCC and Clang only, MSVC doesn't have a 128-bit integer type.
+// Same as digits10_constexpr(): the bit width estimates the digits and one compare against 10^t fixes it up.
+// Mixed magnitudes straddle 2^64 so the bit width is picked without a branch instead of calling digits10_lzcnt() for the low half.
+#if defined(__SIZEOF_INT128__)
+    #define NUMDIGITS_INT128 1
+#else
+    #define NUMDIGITS_INT128 0
+#endif
+
+#if NUMDIGITS_INT128
+// Reference unsigned __int128
+uint32_t numdigits10_uint128( unsigned __int128 n )
+{
+    uint32_t digits = 1;
+    while (n >= 10)
+    {
+        n /= 10;
+        digits++;
+    }
+    return digits;
+}
+
+// Reference __int128
+int32_t numdigits10_int128( __int128 n )
+{
+    const unsigned __int128 x = (n < 0) ? (unsigned __int128)0 - (unsigned __int128)n : (unsigned __int128)n;
+    return (n < 0) + (int32_t)numdigits10_uint128( x );
+}
+
+std::array<unsigned __int128,39> init_pow10_u128()
+{
+    std::array<unsigned __int128,39> values;
+    values[0] = 0; // not 1 so that zero has 1 digit, see Pow10_constexpr[]
+    values[1] = 10;
+    for (size_t i = 2; i < values.size(); i++)
+        values[i] = values[i-1] * 10;
+    return values;
+}
+
+// 10^1 .. 10^38, 10^39 doesn't fit
+const std::array<unsigned __int128,39> Pow10_u128 = init_pow10_u128();
+
+uint32_t digits10_u128( unsigned __int128 n )
+{
+    const uint64_t hi   = (uint64_t)(n >> 64);
+    const uint64_t lo   = (uint64_t) n;
+    const uint32_t mask = 0 - (uint32_t)(hi != 0); // compilers turn ?: into a branch here
+    const uint32_t bits = ((64 + bitwidth_u64( hi )) & mask) | (bitwidth_u64( lo ) & ~mask); // 1 .. 128
+    const uint32_t t    = (bits * 1233) >> 12; // 0 .. 38 = digits or digits - 1
+    return t + (n >= Pow10_u128[ t ]);
+}
+
+int32_t numdigits_i128( __int128 n )
+{
+    const unsigned __int128 x = (n < 0) ? (unsigned __int128)0 - (unsigned __int128)n : (unsigned __int128)n;
+    return (n < 0) + (int32_t)digits10_u128( x );
+}
+#endif // NUMDIGITS_INT128
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Big integers: little-endian array of uint64_t limbs, leading zero limbs are allowed
+//     size_t digits10_bigint( const uint64_t *aLimbs, size_t nLimbs )
+// Converting to decimal just to get the length is quadratic. Instead, as with digits10_lzcnt(),
+// the bit length gives the minimum digits = digits( 2^(bits-1) ) and there is at most one power of 10
+// between 2^(bits-1) and 2^bits, so one compare against it gives the answer.
+// The top 128 bits of that power of 10 come from a table of 10^(2^i) with a bound on the rounding error,
+// which nearly always decides the compare from the top 128 bits of n alone. Only n inside that error
+// window needs the exact power of 10; each thread keeps the last one built per limb count (mod 16).
+// No lock and no cache that grows with the bit lengths seen. One or two limbs are compared directly.
+
+// 64 x 64 -> 128 bit multiply, returns the low half
+inline uint64_t mul_u64( uint64_t a, uint64_t b, uint64_t *pHi )
+{
+#if NUMDIGITS_INT128
+    const unsigned __int128 product = (unsigned __int128)a * b;
+    *pHi = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#elif _MSC_VER
+    return _umul128( a, b, pHi );
+#else
+    #error "mul_u64() needs a 64 x 64 -> 128 bit multiply"
+#endif
+}
+
+// 128 / 64 -> 64 bit divide, hi < divisor
+inline uint64_t div_u128( uint64_t hi, uint64_t lo, uint64_t divisor, uint64_t *pRemainder )
+{
+#if NUMDIGITS_INT128
+    const unsigned __int128 dividend = ((unsigned __int128)hi << 64) | lo;
+    *pRemainder = (uint64_t)(dividend % divisor);
+    return (uint64_t)(dividend / divisor);
+#elif _MSC_VER
+    return _udiv128( hi, lo, divisor, pRemainder );
+#else
+    #error "div_u128() needs a 128 / 64 -> 64 bit divide"
+#endif
+}
+
+// Number of limbs without the leading zero limbs
+inline size_t bigint_size( const uint64_t *aLimbs, size_t nLimbs )
+{
+    while (nLimbs && !aLimbs[ nLimbs - 1 ])
+        nLimbs--;
+    return nLimbs;
+}
+
+// Reference: convert to decimal 19 digits at a time. O(n^2)
+size_t numdigits10_bigint( const uint64_t *aLimbs, size_t nLimbs )
+{
+    std::vector<uint64_t> x( aLimbs, aLimbs + nLimbs );
+    size_t n      = bigint_size( x.data(), x.size() );
+    size_t digits = 0;
+
+    while (n > 1)
+    {
+        uint64_t remainder = 0;
+        for (size_t i = n; i-- > 0; )
+            x[i] = div_u128( remainder, x[i], Pow10_u64[18], &remainder );
+        digits += 19;
+        n = bigint_size( x.data(), n );
+    }
+    return digits + numdigits10_uint64( n ? x[0] : 0 );
+}
+
+// floor( n * log10(2) ) for n < 2^32 using log10(2) in 0.64 fixed point.
+// The error is under 2^-32 so it stays exact far past any bit length we can store.
+inline size_t floor_log10_pow2( uint64_t n )
+{
+    const uint64_t LOG10_2 = 0x4D104D427DE7FBCCull; // floor( log10(2) * 2^64 )
+    const uint64_t hi      = n * (LOG10_2 >> 32);
+    const uint64_t lo      = n * (LOG10_2 & 0xFFFFFFFFull);
+    return (size_t)((hi + (lo >> 32)) >> 32);
+}
+
+// x *= multiplier
+inline void bigint_mul_u64( std::vector<uint64_t>& x, uint64_t multiplier )
+{
+    uint64_t carry = 0;
+    for (uint64_t& limb : x)
+    {
+        uint64_t hi;
+        const uint64_t lo = mul_u64( limb, multiplier, &hi );
+        limb  = lo + carry;
+        carry = hi + (limb < lo);
+    }
+    if (carry)
+        x.push_back( carry );
+}
+
+// digits( 2^(bits-1) ), the fewest digits a number of that bit length can have
+inline size_t bigint_min_digits( size_t bits )
+{
+    return floor_log10_pow2( bits - 1 ) + 1;
+}
+
+// A power of 10 in [Hi:Lo, Hi:Lo + Error) * 2^Exp, with the top bit of Hi set
+struct BigIntPow10Approx
+{
+    uint64_t Hi;
+    uint64_t Lo;
+    int64_t  Exp;
+    uint64_t Error;
+};
+
+// a * b with the 256-bit product of the mantissas rounded down to 128 bits.
+// Each mantissa is < 2^128 and the product is shifted down by at least 127 bits
+// so the error is < 1 + 2 * (a.Error + b.Error) + 1.
+inline BigIntPow10Approx bigint_approx_mul( const BigIntPow10Approx& a, const BigIntPow10Approx& b )
+{
+    uint64_t llHi, lhHi, hlHi, hhHi;
+    mul_u64( a.Lo, b.Lo, &llHi ); // the low 64 bits are below the 128 we keep
+    const uint64_t lh = mul_u64( a.Lo, b.Hi, &lhHi );
+    const uint64_t hl = mul_u64( a.Hi, b.Lo, &hlHi );
+    const uint64_t hh = mul_u64( a.Hi, b.Hi, &hhHi );
+
+    uint64_t p1 = llHi + lh;  uint64_t c1 = (p1 < lh);
+             p1 += hl;                 c1 += (p1 < hl);
+    uint64_t p2 = lhHi + c1;  uint64_t c2 = (p2 < c1);
+             p2 += hlHi;               c2 += (p2 < hlHi);
+             p2 += hh;                 c2 += (p2 < hh);
+    const uint64_t p3 = hhHi + c2;
+
+    BigIntPow10Approx product;
+    product.Error = 2 * (a.Error + b.Error) + 2;
+    if (p3 >> 63)
+    {
+        product.Hi  = p3;
+        product.Lo  = p2;
+        product.Exp = a.Exp + b.Exp + 128;
+    }
+    else
+    {
+        product.Hi  = (p3 << 1) | (p2 >> 63);
+        product.Lo  = (p2 << 1) | (p1 >> 63);
+        product.Exp = a.Exp + b.Exp + 127;
+    }
+    return product;
+}
+
+// 10^(2^i), built once. The error grows about 4x per square, and 4x again over a whole product,
+// so 10^(2^28 - 1) is as far as it stays under 2^64. That is ~890 million bits; past it we use the exact compare.
+#define NUMDIGITS_BIGINT_SQUARES 28
+
+const BigIntPow10Approx* bigint_pow10_squares()
+{
+    struct Squares
+    {
+        BigIntPow10Approx Pow10[ NUMDIGITS_BIGINT_SQUARES ];
+        Squares()
+        {
+            Pow10[0] = { 10ull << 60, 0, -124, 0 }; // exact
+            for (int i = 1; i < NUMDIGITS_BIGINT_SQUARES; i++)
+                Pow10[i] = bigint_approx_mul( Pow10[i-1], Pow10[i-1] );
+        }
+    };
+    static const Squares squares; // thread-safe initialization
+    return squares.Pow10;
+}
+
+// 10^digits for 0 < digits < 2^NUMDIGITS_BIGINT_SQUARES
+inline BigIntPow10Approx bigint_pow10_approx( size_t digits )
+{
+    const BigIntPow10Approx *aSquares = bigint_pow10_squares();
+
+    BigIntPow10Approx pow10 = { 1ull << 63, 0, -127, 0 }; // 1
+    for (int i = 0; digits; i++, digits >>= 1)
+        if (digits & 1)
+            pow10 = bigint_approx_mul( pow10, aSquares[ i ] );
+    return pow10;
+}
+
+// Bits [shift, shift + 128) of x
+inline void bigint_bits128( const uint64_t *aLimbs, size_t nLimbs, size_t shift, uint64_t& hi, uint64_t& lo )
+{
+    const size_t   q     = shift / 64;
+    const unsigned r     = shift % 64;
+    auto           limb  = [&]( size_t i ) { return (i < nLimbs) ? aLimbs[i] : 0; };
+    const uint64_t l0    = limb( q ), l1 = limb( q + 1 ), l2 = limb( q + 2 );
+    lo = r ? (l0 >> r) | (l1 << (64 - r)) : l0;
+    hi = r ? (l1 >> r) | (l2 << (64 - r)) : l1;
+}
+
+// Exact: x >= 10^digits. The last power of 10 built is kept per thread for each limb count (mod slots),
+// so a mix of sizes does not rebuild it on every call
+#define NUMDIGITS_BIGINT_CACHE 16
+
+struct BigIntPow10Cache
+{
+    size_t                Digits; // 0 = empty
+    std::vector<uint64_t> Pow10;
+};
+
+inline bool bigint_ge_pow10_exact( const uint64_t *aLimbs, size_t n, size_t digits )
+{
+    thread_local BigIntPow10Cache aCache[ NUMDIGITS_BIGINT_CACHE ];
+    BigIntPow10Cache&             slot  = aCache[ n % NUMDIGITS_BIGINT_CACHE ];
+    std::vector<uint64_t>&        pow10 = slot.Pow10;
+    if (slot.Digits != digits)
+    {
+        pow10.assign( 1, 1 );
+        for (size_t remaining = digits; remaining; )
+        {
+            const size_t step = std::min( remaining, (size_t)19 );
+            bigint_mul_u64( pow10, Pow10_u64[ step - 1 ] );
+            remaining -= step;
+        }
+        slot.Digits = digits;
+    }
+
+    if (pow10.size() != n)
+        return pow10.size() < n;
+    for (size_t i = n; i-- > 0; )
+        if (aLimbs[i] != pow10[i])
+            return aLimbs[i] > pow10[i];
+    return true;
+}
+
+size_t digits10_bigint( const uint64_t *aLimbs, size_t nLimbs )
+{
+    const size_t n = bigint_size( aLimbs, nLimbs );
+    if (n <= 1)
+        return digits10_lzcnt( n ? aLimbs[0] : 0 );
+
+    const size_t bits   = 64 * (n - 1) + bitwidth_u64( aLimbs[ n - 1 ] );
+    const size_t digits = bigint_min_digits( bits );
+
+    if (n == 2) // 20 .. 39 digits; 10^39 > 2^128, below that 10^digits = 10^19 * 10^(digits-19) fits
+    {
+        if (digits >= 39)
+            return digits;
+        uint64_t       pHi;
+        const uint64_t pLo = mul_u64( Pow10_u64[ 18 ], Pow10_u64[ digits - 20 ], &pHi );
+        return digits + ((aLimbs[1] > pHi) || ((aLimbs[1] == pHi) && (aLimbs[0] >= pLo)));
+    }
+
+    if (digits >> NUMDIGITS_BIGINT_SQUARES)
+        return digits + bigint_ge_pow10_exact( aLimbs, n, digits );
+
+    // x in [X, X + 1) * 2^Exp and 10^digits in [M, M + Error) * 2^Exp
+    const BigIntPow10Approx pow10 = bigint_pow10_approx( digits );
+    const uint64_t          mLo   = pow10.Lo + pow10.Error;
+    const uint64_t          mHi   = pow10.Hi + (mLo < pow10.Lo); // M + Error, < 2^128 unless Hi wraps to 0
+    if ((pow10.Exp >= 0) && mHi)
+    {
+        if (bits > (size_t)pow10.Exp + 128) // x >= 2^(Exp+128) > M + Error
+            return digits + 1;
+
+        uint64_t xHi, xLo;
+        bigint_bits128( aLimbs, n, (size_t)pow10.Exp, xHi, xLo );
+        if ((xHi < pow10.Hi) || ((xHi == pow10.Hi) && (xLo < pow10.Lo))) // X < M
+            return digits;
+        if ((xHi > mHi) || ((xHi == mHi) && (xLo >= mLo)))               // X >= M + Error
+            return digits + 1;
+    }
+    return digits + bigint_ge_pow10_exact( aLimbs, n, digits );
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Writer: the digit count gives the end of the string so it is filled backwards in one pass,
+// two digits per divide. No allocation, no NUL, returns the number of chars written like std::to_chars().
+//     char buffer[ max_digits<int>::value ];
+//     int  len = numdigits_write( buffer, n );
+#include <string.h> // memcpy()
+
+// "00" "01" .. "99"
+const char Digits10_Pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Writes the digits of n ending just before pEnd
+inline void digits10_write_backwards_u32( char *pEnd, uint32_t n )
+{
+    while (n >= 100)
+    {
+        const uint32_t pair = n % 100;
+        n /= 100;
+        pEnd -= 2;
+        memcpy( pEnd, &Digits10_Pairs[ pair * 2 ], 2 );
+    }
+    if (n >= 10)
+        memcpy( pEnd - 2, &Digits10_Pairs[ n * 2 ], 2 );
+    else
+        pEnd[-1] = (char)('0' + n);
+}
+
+inline void digits10_write_backwards( char *pEnd, uint64_t n )
+{
+    // 64-bit divides are slower, only use them until the rest fits in 32 bits
+    while (n > UINT32_MAX)
+    {
+        const uint32_t pair = (uint32_t)(n % 100);
+        n /= 100;
+        pEnd -= 2;
+        memcpy( pEnd, &Digits10_Pairs[ pair * 2 ], 2 );
+    }
+    digits10_write_backwards_u32( pEnd, (uint32_t) n );
+}
+
+// pBuffer needs room for max_digits<uint64_t>::value = 20 chars
+uint32_t digits10_write( char *pBuffer, uint64_t n )
+{
+    const uint32_t digits = digits10_lzcnt( n );
+    digits10_write_backwards( pBuffer + digits, n );
+    return digits;
+}
+
+// pBuffer needs room for max_digits<int>::value = 11 chars
+int numdigits_write( char *pBuffer, int n )
+{
+    const uint32_t sign = (n < 0);
+    const uint32_t x    = sign ? 0u - (uint32_t)n : (uint32_t)n;
+    const uint32_t len  = sign + digits10_lzcnt_u32( x );
+    pBuffer[0] = '-'; // overwritten by the first digit if positive
+    digits10_write_backwards_u32( pBuffer + len, x );
+    return (int)len;
+}
+
+// pBuffer needs room for max_digits<int64_t>::value = 20 chars
+int32_t numdigits_write_int64( char *pBuffer, int64_t n )
+{
+    const uint32_t sign = (n < 0);
+    const uint64_t x    = sign ? 0ull - (uint64_t)n : (uint64_t)n;
+    const uint32_t len  = sign + digits10_lzcnt( x );
+    pBuffer[0] = '-';
+    digits10_write_backwards( pBuffer + len, x );
+    return (int32_t)len;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Grouped: the length with thousands separators, e.g. 1,234,567 and -2,147,483,648
+//     int len = numdigits_grouped( n );                                   // ',' every 3 digits
+//     int len = numdigits_grouped( n, 3, 3 );                             // U+202F narrow no-break space is 3 bytes of UTF-8
+//     int len = numdigits_write_grouped( buffer, n, 3, "\xE2\x80\xAF", 3 );
+// A number of d digits has (d - 1) / group separators. The group is only known at run time
+// so the divide is a multiply by a 16-bit reciprocal and a shift, exact for d <= 20 and group <= 20.
+// group = 0 means no separators, and so does any group >= 20 since no number has more than 20 digits.
+// The writers take a separator of 1 .. 3 bytes.
+
+// ceil( 65536 / group )
+constexpr uint32_t Digits10_Group_Reciprocal[21] = {
+    0, 65536, 32768, 21846, 16384, 13108, 10923, 9363, 8192, 7282, 6554,
+    5958, 5462, 5042, 4682, 4370, 4096, 3856, 3641, 3450, 3277
+};
+
+// Any group >= 20 is clamped to 20, which has no separators
+constexpr uint32_t digits10_separators( uint32_t digits, uint32_t group )
+{
+    return ((digits - 1) * Digits10_Group_Reciprocal[ (group < 20) ? group : 20 ]) >> 16;
+}
+
+uint32_t digits10_grouped( uint64_t n, uint32_t group = 3, uint32_t nSeparatorBytes = 1 )
+{
+    const uint32_t digits = digits10_lzcnt( n );
+    return digits + digits10_separators( digits, group ) * nSeparatorBytes;
+}
+
+int numdigits_grouped( int n, uint32_t group = 3, uint32_t nSeparatorBytes = 1 )
+{
+    const uint32_t sign   = (n < 0);
+    const uint32_t x      = sign ? 0u - (uint32_t)n : (uint32_t)n;
+    const uint32_t digits = digits10_lzcnt_u32( x );
+    return (int)(sign + digits + digits10_separators( digits, group ) * nSeparatorBytes);
+}
+
+int32_t numdigits_grouped_int64( int64_t n, uint32_t group = 3, uint32_t nSeparatorBytes = 1 )
+{
+    const uint32_t sign   = (n < 0);
+    const uint64_t x      = sign ? 0ull - (uint64_t)n : (uint64_t)n;
+    const uint32_t digits = digits10_lzcnt( x );
+    return (int32_t)(sign + digits + digits10_separators( digits, group ) * nSeparatorBytes);
+}
+
+// The separator is 1 .. 3 bytes, copied without a call to memcpy()
+inline char *digits10_write_separator( char *pEnd, const char *pSeparator, uint32_t nSeparatorBytes )
+{
+    assert( (nSeparatorBytes >= 1) && (nSeparatorBytes <= 3) );
+    pEnd -= nSeparatorBytes;
+    pEnd[0] = pSeparator[0];
+    if (nSeparatorBytes > 1) pEnd[1] = pSeparator[1];
+    if (nSeparatorBytes > 2) pEnd[2] = pSeparator[2];
+    return pEnd;
+}
+
+// Exactly width digits of n < 10^width, zero padded, ending just before pEnd
+inline char *digits10_write_backwards_padded( char *pEnd, uint64_t n, uint32_t width )
+{
+    for (; width >= 2; width -= 2)
+    {
+        pEnd -= 2;
+        memcpy( pEnd, &Digits10_Pairs[ (n % 100) * 2 ], 2 );
+        n /= 100;
+    }
+    if (width)
+        *--pEnd = (char)('0' + n);
+    return pEnd;
+}
+
+// Groups of 3 digits, one divide each, while n >= nStop
+template <typename T>
+inline char *digits10_write_backwards_thousands( char *pEnd, T& n, T nStop, const char *pSeparator, uint32_t nSeparatorBytes )
+{
+    while (n >= nStop)
+    {
+        const uint32_t triple = (uint32_t)(n % 1000);
+        n /= 1000;
+        pEnd -= 3;
+        pEnd[0] = (char)('0' + triple / 100);
+        memcpy( pEnd + 1, &Digits10_Pairs[ (triple % 100) * 2 ], 2 );
+        pEnd = digits10_write_separator( pEnd, pSeparator, nSeparatorBytes );
+    }
+    return pEnd;
+}
+
+// Writes the digits and separators of n ending just before pEnd
+inline void digits10_write_backwards_grouped( char *pEnd, uint64_t n, uint32_t group, const char *pSeparator, uint32_t nSeparatorBytes )
+{
+    if ((group == 0) || (group >= 20))
+        return digits10_write_backwards( pEnd, n );
+
+    if (group == 3)
+    {
+        // 64-bit divides are slower, only use them until the rest fits in 32 bits
+        pEnd = digits10_write_backwards_thousands<uint64_t>( pEnd, n, 1ull << 32, pSeparator, nSeparatorBytes );
+        uint32_t x = (uint32_t) n;
+        pEnd = digits10_write_backwards_thousands<uint32_t>( pEnd, x, 1000, pSeparator, nSeparatorBytes );
+        return digits10_write_backwards_u32( pEnd, x );
+    }
+
+    // Other groups: one divide by 10^group per group, then its digits zero padded two at a time
+    const uint64_t pow10 = Pow10_u64[ group - 1 ];
+    while (n >= pow10)
+    {
+        pEnd = digits10_write_backwards_padded( pEnd, n % pow10, group );
+        n /= pow10;
+        pEnd = digits10_write_separator( pEnd, pSeparator, nSeparatorBytes );
+    }
+    digits10_write_backwards( pEnd, n );
+}
+
+// pBuffer needs room for digits10_grouped( n, group, nSeparatorBytes ) chars, at most 20 + 19*3 = 77
+uint32_t digits10_write_grouped( char *pBuffer, uint64_t n, uint32_t group = 3, const char *pSeparator = ",", uint32_t nSeparatorBytes = 1 )
+{
+    const uint32_t digits = digits10_lzcnt( n );
+    const uint32_t len    = digits + digits10_separators( digits, group ) * nSeparatorBytes;
+    digits10_write_backwards_grouped( pBuffer + len, n, group, pSeparator, nSeparatorBytes );
+    return len;
+}
+
+// pBuffer needs room for numdigits_grouped( n, group, nSeparatorBytes ) chars, at most 11 + 9*3 = 38
+int numdigits_write_grouped( char *pBuffer, int n, uint32_t group = 3, const char *pSeparator = ",", uint32_t nSeparatorBytes = 1 )
+{
+    const uint32_t sign   = (n < 0);
+    const uint32_t x      = sign ? 0u - (uint32_t)n : (uint32_t)n;
+    const uint32_t digits = digits10_lzcnt_u32( x );
+    const uint32_t len    = sign + digits + digits10_separators( digits, group ) * nSeparatorBytes;
+    pBuffer[0] = '-'; // overwritten by the first digit if positive
+    digits10_write_backwards_grouped( pBuffer + len, x, group, pSeparator, nSeparatorBytes );
+    return (int)len;
+}
+
+// pBuffer needs room for numdigits_grouped_int64( n, group, nSeparatorBytes ) chars, at most 20 + 18*3 = 74
+int32_t numdigits_write_grouped_int64( char *pBuffer, int64_t n, uint32_t group = 3, const char *pSeparator = ",", uint32_t nSeparatorBytes = 1 )
+{
+    const uint32_t sign   = (n < 0);
+    const uint64_t x      = sign ? 0ull - (uint64_t)n : (uint64_t)n;
+    const uint32_t digits = digits10_lzcnt( x );
+    const uint32_t len    = sign + digits + digits10_separators( digits, group ) * nSeparatorBytes;
+    pBuffer[0] = '-';
+    digits10_write_backwards_grouped( pBuffer + len, x, group, pSeparator, nSeparatorBytes );
+    return (int32_t)len;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Fixed point: an int64_t scaled by 10^scale printed as a decimal, e.g. money in cents as -123.45
+//     int len = numdigits_fixed_point( -12345, 2 );         // 7 "-123.45"
+//     int len = numdigits_fixed_point(      5, 2 );         // 4 "0.05"
+//     int len = numdigits_fixed_point(    250, 2, true );   // 3 "2.5", trailing zeros trimmed, "2" for 200
+//     int len = numdigits_write_fixed_point( buffer, n, 2 );
+// The length is the '-', the integer digits or "0" below 10^scale, the '.' and scale fraction digits:
+// one digit count and no formatting. Trimming also needs the trailing zeros of the fraction,
+// found with 5 divisibility tests instead of a loop. A fraction of all zeros is dropped with its '.'.
+// scale is 0 .. 18, 0 is a plain integer.
+
+// Trailing decimal zeros of f > 0
+inline uint32_t digits10_trailing_zeros( uint64_t f )
+{
+    uint32_t zeros = 0;
+    if (f % 10'000'000'000'000'000ull == 0) { f /= 10'000'000'000'000'000ull; zeros += 16; }
+    if (f %                100'000'000ull == 0) { f /=                100'000'000ull; zeros +=  8; }
+    if (f %                     10'000ull == 0) { f /=                     10'000ull; zeros +=  4; }
+    if (f %                        100ull == 0) { f /=                        100ull; zeros +=  2; }
+    if (f %                         10ull == 0) {                                     zeros +=  1; }
+    return zeros;
+}
+
+int32_t numdigits_fixed_point( int64_t n, uint32_t scale, bool bTrim = false )
+{
+    assert( scale <= 18 );
+    const uint32_t sign   = (n < 0);
+    const uint64_t x      = sign ? 0ull - (uint64_t)n : (uint64_t)n;
+    const uint32_t digits = digits10_lzcnt( x );
+    if (scale == 0)
+        return (int32_t)(sign + digits);
+
+    const uint32_t integer  = (digits > scale) ? digits - scale : 1;
+    uint32_t       fraction = scale;
+    if (bTrim)
+    {
+        const uint64_t f = x % Pow10_constexpr[ scale ];
+        if (!f)
+            return (int32_t)(sign + integer);
+        fraction -= digits10_trailing_zeros( f );
+    }
+    return (int32_t)(sign + integer + 1 + fraction);
+}
+
+// pBuffer needs room for numdigits_fixed_point( n, scale, bTrim ) chars, at most 21 "-9.223372036854775808"
+int32_t numdigits_write_fixed_point( char *pBuffer, int64_t n, uint32_t scale, bool bTrim = false )
+{
+    assert( scale <= 18 );
+    const uint32_t sign = (n < 0);
+    const uint64_t x    = sign ? 0ull - (uint64_t)n : (uint64_t)n;
+    pBuffer[0] = '-'; // overwritten by the first digit if positive
+    if (scale == 0)
+    {
+        const uint32_t len = sign + digits10_lzcnt( x );
+        digits10_write_backwards( pBuffer + len, x );
+        return (int32_t)len;
+    }
+
+    const uint64_t integer  = x / Pow10_constexpr[ scale ];
+    uint64_t       f        = x % Pow10_constexpr[ scale ];
+    uint32_t       fraction = scale;
+    if (bTrim)
+    {
+        const uint32_t zeros = f ? digits10_trailing_zeros( f ) : scale;
+        if (f && zeros)
+            f /= Pow10_constexpr[ zeros ];
+        fraction -= zeros;
+    }
+
+    const uint32_t len  = sign + digits10_lzcnt( integer ) + (fraction ? 1 + fraction : 0);
+    char          *pEnd = pBuffer + len;
+    if (fraction)
+    {
+        pEnd -= fraction + 1;
+        pEnd[0] = '.';
+        memset( pEnd + 1, '0', fraction ); // leading zeros of the fraction
+        digits10_write_backwards( pEnd + 1 + fraction, f );
+    }
+    digits10_write_backwards( pEnd, integer );
+    return (int32_t)len;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Floating point: length of the shortest round-trip text of a double or float, e.g. to presize JSON
+//     int len = numdigits_double( 0.1 );          //  3 "0.1"
+//     int len = numdigits_double( 1e100 );        //  6 "1e+100"
+//     int len = numdigits_float( 1.0f / 3 );      // 10 "0.33333334"
+// The text is printf( "%.*g", p, v ) with the smallest precision p that reads back as v, which is what
+// a "%.17g, then try fewer digits" serializer writes. p is the digit count of the shortest decimal
+// significand: Schubfach (Giulietti), one lookup in a table of 128-bit powers of 10 and three multiplies,
+// then digits10_lzcnt() of the significand without its trailing zeros. The rest is the %g layout:
+// fixed when -4 <= exponent < p, else d.ddde+XX with at least 2 exponent digits.
+// A power of 2 has a closer lower neighbor, so its shortest significand is not always the correctly
+// rounded one that %g prints. For those few (48 doubles, 3 floats) p is longer and this falls back to snprintf().
+#include <stdio.h>  // snprintf()
+#include <stdlib.h> // strtod() strtof()
+
+// g(e) = floor( 10^e * 2^(127 - floor(log2(10^e))) ) + 1, the top 128 bits of 10^e rounded up
+struct digits10_float_tables
+{
+    enum { MIN = -292, MAX = 326, LIMBS = 40 }; // 32-bit limbs, 10^326 and 2^1279 fit
+
+    uint64_t Hi[ MAX - MIN + 1 ];
+    uint64_t Lo[ MAX - MIN + 1 ];
+
+    static constexpr int bitwidth( const uint32_t (&aLimbs)[ LIMBS ] )
+    {
+        int i = LIMBS - 1;
+        while (!aLimbs[ i ])
+            i--;
+        int bits = 32;
+        while (!(aLimbs[ i ] >> (bits - 1)))
+            bits--;
+        return i*32 + bits;
+    }
+
+    // Bits [shift, shift + 64), a negative shift is a left shift
+    static constexpr uint64_t bits64( const uint32_t (&aLimbs)[ LIMBS ], int shift )
+    {
+        uint64_t bits = 0;
+        for (int i = 0; i < 64; i++)
+        {
+            const int bit = shift + i;
+            if ((bit >= 0) && (bit < LIMBS*32) && ((aLimbs[ bit / 32 ] >> (bit % 32)) & 1))
+                bits |= 1ull << i;
+        }
+        return bits;
+    }
+
+    constexpr void set( int e, const uint32_t (&aLimbs)[ LIMBS ] )
+    {
+        const int shift = bitwidth( aLimbs ) - 128;
+        uint64_t  lo    = bits64( aLimbs, shift ) + 1;
+        uint64_t  hi    = bits64( aLimbs, shift + 64 ) + (lo == 0);
+        Hi[ e - MIN ] = hi;
+        Lo[ e - MIN ] = lo;
+    }
+
+    constexpr digits10_float_tables() : Hi(), Lo()
+    {
+        uint32_t pow10[ LIMBS ] = { 1 };
+        for (int e = 0; e <= MAX; e++)
+        {
+            set( e, pow10 );
+            uint64_t carry = 0;
+            for (uint32_t& limb : pow10)
+            {
+                const uint64_t x = (uint64_t)limb * 10 + carry;
+                limb  = (uint32_t)x;
+                carry = x >> 32;
+            }
+        }
+
+        // 10^-e as floor( 2^1279 / 10^e ): the floor of a floor divided by 10 is still the floor
+        uint32_t inverse[ LIMBS ] = {};
+        inverse[ LIMBS - 1 ] = 0x80000000u;
+        for (int e = -1; e >= MIN; e--)
+        {
+            uint64_t remainder = 0;
+            for (int i = LIMBS - 1; i >= 0; i--)
+            {
+                const uint64_t x = (remainder << 32) | inverse[ i ];
+                inverse[ i ] = (uint32_t)(x / 10);
+                remainder    = x % 10;
+            }
+            set( e, inverse );
+        }
+    }
+};
+
+constexpr digits10_float_tables Digits10_Float_Pow10;
+
+// The usual fixed-point log approximations, exact over the exponents of a double (>> of a negative int is a floor)
+// _i32 keeps the signed one apart from the size_t floor_log10_pow2() of the big integers
+inline int32_t floor_log2_pow10( int32_t e ) { return (e * 1741647) >> 19; }
+inline int32_t floor_log10_pow2_i32( int32_t e ) { return (e * 1262611) >> 22; }
+inline int32_t floor_log10_three_quarters_pow2( int32_t e ) { return (e * 1262611 - 524031) >> 22; }
+
+// High 64 bits of g * cp rounded to odd, so a compare against an even midpoint stays exact
+inline uint64_t round_to_odd_u64( uint64_t gHi, uint64_t gLo, uint64_t cp )
+{
+    uint64_t xHi, yHi;
+    mul_u64( gLo, cp, &xHi );
+    const uint64_t yLo = mul_u64( gHi, cp, &yHi ) + xHi;
+    yHi += (yLo < xHi);
+    return yHi | (yLo > 1);
+}
+
+struct NumDigitsDecimal
+{
+    uint64_t Digits;   // significand, may have trailing zeros
+    int32_t  Exponent; // value = Digits * 10^Exponent
+    bool     Nearest;  // Digits is what printf() rounds to, false only for some powers of 2
+};
+
+// Shortest decimal in the rounding interval of c * 2^q, c > 0
+inline NumDigitsDecimal digits10_shortest( uint64_t c, int32_t q, bool bLowerCloser )
+{
+    const bool     even = (c % 2 == 0); // round half to even, so the interval includes its bounds
+    const uint64_t cbl  = 4*c - 2 + bLowerCloser;
+    const uint64_t cb   = 4*c;
+    const uint64_t cbr  = 4*c + 2;
+
+    const int32_t  k   = bLowerCloser ? floor_log10_three_quarters_pow2( q ) : floor_log10_pow2_i32( q );
+    const int32_t  h   = q + floor_log2_pow10( -k ) + 1;
+    const uint64_t gHi = Digits10_Float_Pow10.Hi[ -k - digits10_float_tables::MIN ];
+    const uint64_t gLo = Digits10_Float_Pow10.Lo[ -k - digits10_float_tables::MIN ];
+
+    const uint64_t vbl   = round_to_odd_u64( gHi, gLo, cbl << h );
+    const uint64_t vb    = round_to_odd_u64( gHi, gLo, cb  << h );
+    const uint64_t vbr   = round_to_odd_u64( gHi, gLo, cbr << h );
+    const uint64_t lower = vbl + !even;
+    const uint64_t upper = vbr - !even;
+
+    // One digit less if only one of its two neighbors is in the interval
+    const uint64_t s = vb / 4;
+    if (s >= 10)
+    {
+        const uint64_t sp        = s / 10;
+        const bool     up_inside = lower <= 40*sp;
+        const bool     wp_inside = 40*sp + 40 <= upper;
+        if (up_inside != wp_inside)
+        {
+            const uint64_t mid = 40*sp + 20;
+            const bool nearest = wp_inside ? (vb > mid) || ((vb == mid) &&  (sp & 1))
+                                           : (vb < mid) || ((vb == mid) && !(sp & 1));
+            return { sp + wp_inside, k + 1, nearest };
+        }
+    }
+
+    const uint64_t mid      = 4*s + 2;
+    const bool     u_inside = lower <= 4*s;
+    const bool     w_inside = 4*s + 4 <= upper;
+    if (u_inside != w_inside)
+    {
+        const bool nearest = w_inside ? (vb > mid) || ((vb == mid) &&  (s & 1))
+                                      : (vb < mid) || ((vb == mid) && !(s & 1));
+        return { s + w_inside, k, nearest };
+    }
+
+    const bool round_up = (vb > mid) || ((vb == mid) && (s & 1));
+    return { s + round_up, k, true };
+}
+
+// %g layout of p significant digits whose first digit is at 10^x
+inline int numdigits_general( uint32_t sign, int32_t p, int32_t x )
+{
+    if ((x < -4) || (x >= p))
+        return (int)sign + p + (p > 1) + 2 + 2 + (x <= -100 || x >= 100); // d.ddd e+XX
+    if (x >= 0)
+        return (int)sign + p + (p > x + 1);                                // ddd.ddd
+    return (int)sign + 1 - x + p;                                         // 0.000ddd
+}
+
+// digits * 10^exponent, the trailing zeros of digits > 0 are not significant
+inline int numdigits_general_decimal( uint32_t sign, uint64_t digits, int32_t exponent )
+{
+    const int32_t n = (int32_t) digits10_lzcnt( digits );
+    const int32_t p = (digits % 10) ? n : n - (int32_t) digits10_trailing_zeros( digits );
+    return numdigits_general( sign, p, exponent + n - 1 );
+}
+
+template <typename T>
+int numdigits_general_snprintf( T v )
+{
+    char text[ 32 ];
+    for (int precision = 1; ; precision++)
+    {
+        const int len = snprintf( text, sizeof(text), "%.*g", precision, (double)v );
+        if ((sizeof(T) == sizeof(float) ? (T)strtof( text, nullptr ) : (T)strtod( text, nullptr )) == v)
+            return len;
+    }
+}
+
+template <typename T, typename Bits, int SignificandBits, int ExponentBias>
+int numdigits_floating( T v )
+{
+    Bits bits;
+    memcpy( &bits, &v, sizeof(bits) );
+
+    const uint32_t sign        = (uint32_t)(bits >> (sizeof(T)*8 - 1));
+    const Bits     significand = bits & (((Bits)1 << SignificandBits) - 1);
+    const int32_t  exponent    = (int32_t)((bits >> SignificandBits) & ((1u << (sizeof(T)*8 - 1 - SignificandBits)) - 1));
+
+    if (exponent == ((1 << (sizeof(T)*8 - 1 - SignificandBits)) - 1))
+        return (int)sign + 3; // inf nan
+    if (!exponent && !significand)
+        return (int)sign + 1; // 0
+
+    uint64_t c = significand;
+    int32_t  q = 1 - ExponentBias;
+    if (exponent)
+    {
+        c |= (uint64_t)1 << SignificandBits;
+        q  = exponent - ExponentBias;
+        if ((q <= 0) && (-q <= SignificandBits) && !(c & (((uint64_t)1 << -q) - 1))) // integer
+            return numdigits_general_decimal( sign, c >> -q, 0 );
+    }
+
+    const NumDigitsDecimal decimal = digits10_shortest( c, q, !significand && (exponent > 1) );
+    if (!decimal.Nearest)
+        return numdigits_general_snprintf( v );
+
+    return numdigits_general_decimal( sign, decimal.Digits, decimal.Exponent );
+}
+
+int numdigits_double( double v )
+{
+    return numdigits_floating<double, uint64_t, 52, 1075>( v );
+}
+
+int numdigits_float( float v )
+{
+    return numdigits_floating<float, uint32_t, 23, 150>( v );
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Magnitude: integer log10() and pow() for bucketing, without the conversion to double
+//     uint32_t e = floor_log10( 4096 );                  //    3
+//     uint32_t e = ceil_log10( 4096 );                   //    4
+//     uint64_t p = pow10_floor( 4096 );                  // 1000
+//     uint64_t p = pow10_ceil( 4096 );                   // 10000
+//     uint64_t x = truncate_significant10( 4096, 2 );    // 4000
+//     uint64_t x = round_significant10( 4096, 2 );       // 4100
+//     bool     b = fits_digits10( 4096, 3 );             // false
+// Each is one digits10_lzcnt() and a table lookup. Only the significant digit ones also divide.
+// Zero is treated as 1 like bitwidth_u64(). log10( (double)n ) is off by one just below the powers
+// of 10 above 2^53, e.g. 999'999'999'999'999'999 rounds to 1e18.
+
+// 10^k for k = 0 .. 20 from Pow10_constexpr[], whose [0] is 0, and 0 for 10^20 which doesn't fit
+inline uint64_t digits10_pow10( uint32_t k )
+{
+    return (k < 20) ? Pow10_constexpr[ k ] + (k == 0) : 0;
+}
+
+// 0 .. 19
+inline uint32_t floor_log10( uint64_t n )
+{
+    return digits10_lzcnt( n ) - 1;
+}
+
+// 0 .. 20, the digits of n - 1 since 10^k itself needs k
+inline uint32_t ceil_log10( uint64_t n )
+{
+    return (n <= 1) ? 0 : digits10_lzcnt( n - 1 );
+}
+
+// Largest power of 10 <= n
+inline uint64_t pow10_floor( uint64_t n )
+{
+    return digits10_pow10( floor_log10( n ) );
+}
+
+// Smallest power of 10 >= n, 0 above 10^19
+inline uint64_t pow10_ceil( uint64_t n )
+{
+    return digits10_pow10( ceil_log10( n ) );
+}
+
+// n < 10^digits, i.e. numdigits() <= digits
+inline bool fits_digits10( uint64_t n, uint32_t digits )
+{
+    return digits10_lzcnt( n ) <= digits;
+}
+
+// Keeps the first 1 .. 20 digits and zeros the rest, 4096 -> 4000
+inline uint64_t truncate_significant10( uint64_t n, uint32_t digits )
+{
+    assert( digits >= 1 );
+    const uint32_t length = digits10_lzcnt( n );
+    if (length <= digits)
+        return n;
+    const uint64_t unit = Pow10_constexpr[ length - digits ]; // 1 .. 19
+    return n - n % unit;
+}
+
+// Rounds half up to the first 1 .. 20 digits, 4096 -> 4100 and 9960 -> 10000.
+// A 20 digit n that rounds past UINT64_MAX returns 0 like pow10_ceil().
+inline uint64_t round_significant10( uint64_t n, uint32_t digits )
+{
+    assert( digits >= 1 );
+    const uint32_t length = digits10_lzcnt( n );
+    if (length <= digits)
+        return n;
+    const uint64_t unit      = Pow10_constexpr[ length - digits ]; // 1 .. 19
+    const uint64_t remainder = n % unit;
+    const uint64_t truncated = n - remainder;
+    if (remainder < unit - remainder) // 2*remainder < unit without overflow
+        return truncated;
+    return (truncated > UINT64_MAX - unit) ? 0 : truncated + unit;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Batch: count the digits of a whole array of int
+//     void numdigits_batch_*( const int32_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define NUMDIGITS_X86 1
+    #include <immintrin.h>
+    #if _MSC_VER
+        #define NUMDIGITS_TARGET_SSE41
+        #define NUMDIGITS_TARGET_LZCNT
+        #define NUMDIGITS_TARGET_AVX2
+        #define NUMDIGITS_TARGET_AVX512
+    #else
+        #include <cpuid.h> // __get_cpuid()
+        #define NUMDIGITS_TARGET_SSE41  __attribute__((target("sse4.1")))
+        #define NUMDIGITS_TARGET_LZCNT  __attribute__((target("lzcnt")))
+        #define NUMDIGITS_TARGET_AVX2   __attribute__((target("avx2")))
+        #define NUMDIGITS_TARGET_AVX512 __attribute__((target("avx512f,avx512cd")))
+    #endif
+#else
+    #define NUMDIGITS_X86 0
+#endif
+
+enum NumDigitsCPU_e
+{
+      NUMDIGITS_CPU_SSE41  = (1 << 0)
+    , NUMDIGITS_CPU_LZCNT  = (1 << 1)
+    , NUMDIGITS_CPU_AVX2   = (1 << 2)
+    , NUMDIGITS_CPU_AVX512 = (1 << 3) // F + CD
+    , NUMDIGITS_CPU_NONE   = 0
+};
+
+// The SIMD kernels are always compiled on x86 but we can only run them if the CPU (and OS) supports them
+int cpu_features()
+{
+    int features = NUMDIGITS_CPU_NONE;
+#if NUMDIGITS_X86
+    #if _MSC_VER
+        int info[4];
+        __cpuid( info, 0 );
+        const int nIds = info[0];
+        __cpuid( info, 0x80000000 );
+        const unsigned int nExtIds = (unsigned int) info[0];
+
+        __cpuid( info, 1 );
+        const bool     sse41   = (info[2] & (1 << 19)) != 0;
+        const bool     osxsave = (info[2] & (1 << 27)) != 0;
+        const bool     avx     = (info[2] & (1 << 28)) != 0;
+        const uint64_t xcr0    = osxsave ? _xgetbv( 0 ) : 0;
+        const bool     ymm     = (xcr0 & 0x06) == 0x06; // OS saves YMM
+        const bool     zmm     = (xcr0 & 0xE6) == 0xE6; // OS saves ZMM and opmask
+
+        int ebx7 = 0;
+        if (nIds >= 7) {
+            __cpuidex( info, 7, 0 );
+            ebx7 = info[1];
+        }
+
+        bool lzcnt = false;
+        if (nExtIds >= 0x80000001) {
+            __cpuid( info, 0x80000001 );
+            lzcnt = (info[2] & (1 << 5)) != 0;
+        }
+
+        if (sse41)                                                    features |= NUMDIGITS_CPU_SSE41;
+        if (lzcnt)                                                    features |= NUMDIGITS_CPU_LZCNT;
+        if (avx && ymm && (ebx7 & (1 << 5)))                          features |= NUMDIGITS_CPU_AVX2;
+        if (avx && zmm && (ebx7 & (1 << 16)) && (ebx7 & (1 << 28)))   features |= NUMDIGITS_CPU_AVX512;
+    #else
+        __builtin_cpu_init(); // We may be called from a static initializer
+        unsigned int eax, ebx, ecx = 0, edx;
+        const bool lzcnt = __get_cpuid( 0x80000001, &eax, &ebx, &ecx, &edx ) && (ecx & (1 << 5));
+
+        if (__builtin_cpu_supports( "sse4.1" ))                                            features |= NUMDIGITS_CPU_SSE41;
+        if (lzcnt)                                                                         features |= NUMDIGITS_CPU_LZCNT;
+        if (__builtin_cpu_supports( "avx2" ))                                              features |= NUMDIGITS_CPU_AVX2;
+        if (__builtin_cpu_supports( "avx512f" ) && __builtin_cpu_supports( "avx512cd" ))  features |= NUMDIGITS_CPU_AVX512;
+    #endif
+#endif
+    return features;
+}
+
+bool cpu_has_avx2()
+{
+    return (cpu_features() & NUMDIGITS_CPU_AVX2) != 0;
+}
+
+typedef void (*NumDigitsBatchFuncPtr   )( const int32_t *, size_t, uint8_t* );
+typedef void (*NumDigitsBatchI64FuncPtr)( const int64_t *, size_t, uint8_t* );
+typedef void (*NumDigitsBatchU64FuncPtr)( const uint64_t*, size_t, uint8_t* );
+
+// Scalar fallbacks
+void numdigits_batch_scalar( const int32_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+{
+    for (size_t i = 0; i < nNumbers; i++)
+        aLengths[ i ] = (uint8_t) numdigits_lzcnt( aNumbers[ i ] );
+}
+
+void numdigits_batch_i64_scalar( const int64_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+{
+    for (size_t i = 0; i < nNumbers; i++)
+        aLengths[ i ] = (uint8_t) numdigits_lzcnt_int64( aNumbers[ i ] );
+}
+
+void digits10_batch_u64_scalar( const uint64_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+{
+    for (size_t i = 0; i < nNumbers; i++)
+        aLengths[ i ] = (uint8_t) digits10_lzcnt( aNumbers[ i ] );
+}
+
+// SWAR: two uint32_t per uint64_t, for targets where we can't count on any SIMD
+//
+// a is the low half and b the high half; the digits come back packed the same way.
+// A lane has no spare bit above it so we split off the top bit and compare the low 31 bits l
+// against 10^1 .. 10^9 with l - 10^k + 2^31. Bit 31 is the inverted borrow, set if l >= 10^k,
+// and the sum is < 2^32 so nothing carries into the other lane.
+// A lane with the top bit set is >= 2^31 > 10^9 so its low bits are saturated to pass all 9 compares.
+inline uint64_t digits10_swar_pack( uint32_t a, uint32_t b )
+{
+    return ((uint64_t)b << 32) | a;
+}
+
+// 1 in each lane where the low 31 bits are >= pow10
+inline uint64_t digits10_swar_ge( uint64_t low, uint64_t pow10 )
+{
+    const uint64_t ONES = 0x0000000100000001ull;
+    return ((low + ONES * (0x80000000ull - pow10)) >> 31) & ONES;
+}
+
+inline uint64_t digits10_swar_u32x2( uint64_t ab )
+{
+    const uint64_t ONES  = 0x0000000100000001ull;
+    const uint64_t LOW31 = 0x7FFFFFFF7FFFFFFFull;
+    const uint64_t top   = (ab >> 31) & ONES;
+    const uint64_t low   = (ab & LOW31) | (top * 0x7FFFFFFFull);
+
+    return ONES
+        + digits10_swar_ge( low,            10ull ) + digits10_swar_ge( low,           100ull ) + digits10_swar_ge( low,         1'000ull )
+        + digits10_swar_ge( low,        10'000ull ) + digits10_swar_ge( low,       100'000ull ) + digits10_swar_ge( low,     1'000'000ull )
+        + digits10_swar_ge( low,    10'000'000ull ) + digits10_swar_ge( low,   100'000'000ull ) + digits10_swar_ge( low, 1'000'000'000ull );
+}
+
+// The sign fold is SWAR too: (x ^ mask) + sign per lane, which can't carry since -n - 1 < 2^31
+void numdigits_batch_swar( const int32_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+{
+    const uint64_t ONES = 0x0000000100000001ull;
+
+    size_t i = 0;
+    for (; i + 2 <= nNumbers; i += 2)
+    {
+        const uint64_t ab     = digits10_swar_pack( (uint32_t) aNumbers[ i ], (uint32_t) aNumbers[ i + 1 ] );
+        const uint64_t sign   = (ab >> 31) & ONES;
+        const uint64_t mag    = (ab ^ (sign * 0xFFFFFFFFull)) + sign;
+        const uint64_t digits = digits10_swar_u32x2( mag ) + sign;
+
+        aLengths[ i     ] = (uint8_t) digits;
+        aLengths[ i + 1 ] = (uint8_t)(digits >> 32);
+    }
+    numdigits_batch_scalar( aNumbers + i, nNumbers - i, aLengths + i );
+}
+
+#if NUMDIGITS_X86
+// Same as numdigits_lzcnt() but __builtin_clz() compiles to LZCNT instead of BSR + XOR
+NUMDIGITS_TARGET_LZCNT
+int numdigits_lzcnt_hw( int n )
+{
+    const uint32_t x = (n < 0) ? 0u - (uint32_t)n : (uint32_t)n;
+    return (n < 0) + digits10_lzcnt_u32( x );
+}
+
+// 4 lanes at once, see numdigits_avx2_epi32() for the negative fold
+NUMDIGITS_TARGET_SSE41
+inline __m128i numdigits_sse41_epi32( __m128i n )
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i nabs = _mm_min_epi32( n, _mm_sub_epi32( zero, n ) ); // -|n|
+    __m128i       sum  = _mm_srai_epi32( n, 31 );                      // -1 if negative for '-'
+
+    sum = _mm_add_epi32( sum, _mm_cmpgt_epi32( _mm_set1_epi32( 1 -            10 ), nabs ) );
+    sum = _mm_add_epi32( sum, _mm_cmpgt_epi32( _mm_set1_epi32( 1 -           100 ), nabs ) );
+    sum = _mm_add_epi32( sum, _mm_cmpgt_epi32( _mm_set1_epi32( 1 -         1'000 ), nabs ) );
+    sum = _mm_add_epi32( sum, _mm_cmpgt_epi32( _mm_set1_epi32( 1 -        10'000 ), nabs ) );
+    sum = _mm_add_epi32( sum, _mm_cmpgt_epi32( _mm_set1_epi32( 1 -       100'000 ), nabs ) );
+    sum = _mm_add_epi32( sum, _mm_cmpgt_epi32( _mm_set1_epi32( 1 -     1'000'000 ), nabs ) );
+    sum = _mm_add_epi32( sum, _mm_cmpgt_epi32( _mm_set1_epi32( 1 -    10'000'000 ), nabs ) );
+    sum = _mm_add_epi32( sum, _mm_cmpgt_epi32( _mm_set1_epi32( 1 -   100'000'000 ), nabs ) );
+    sum = _mm_add_epi32( sum, _mm_cmpgt_epi32( _mm_set1_epi32( 1 - 1'000'000'000 ), nabs ) );
+
+    return _mm_sub_epi32( _mm_set1_epi32( 1 ), sum );
+}
+
+NUMDIGITS_TARGET_SSE41
+void numdigits_batch_sse41( const int32_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+{
+    size_t i = 0;
+    for (; i + 16 <= nNumbers; i += 16)
+    {
+        const __m128i d0 = numdigits_sse41_epi32( _mm_loadu_si128( (const __m128i*)(aNumbers + i +  0) ) );
+        const __m128i d1 = numdigits_sse41_epi32( _mm_loadu_si128( (const __m128i*)(aNumbers + i +  4) ) );
+        const __m128i d2 = numdigits_sse41_epi32( _mm_loadu_si128( (const __m128i*)(aNumbers + i +  8) ) );
+        const __m128i d3 = numdigits_sse41_epi32( _mm_loadu_si128( (const __m128i*)(aNumbers + i + 12) ) );
+
+        const __m128i d01 = _mm_packs_epi32( d0, d1 );
+        const __m128i d23 = _mm_packs_epi32( d2, d3 );
+        _mm_storeu_si128( (__m128i*)(aLengths + i), _mm_packus_epi16( d01, d23 ) );
+    }
+    numdigits_batch_scalar( aNumbers + i, nNumbers - i, aLengths + i );
+}
+
+// 8 lanes at once.
+// abs(INT_MIN) doesn't fit in int so instead we fold to the NEGATIVE magnitude, -|n|, which always fits:
+//     |n| >= 10^k  <=>  -|n| <= -10^k  <=>  (1 - 10^k) > -|n|
+// Each compare is 0 or -1 so we accumulate them, along with the sign mask, and subtract from 1.
+NUMDIGITS_TARGET_AVX2
+inline __m256i numdigits_avx2_epi32( __m256i n )
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i nabs = _mm256_min_epi32( n, _mm256_sub_epi32( zero, n ) ); // -|n|
+    __m256i       sum  = _mm256_srai_epi32( n, 31 );                         // -1 if negative for '-'
+
+    sum = _mm256_add_epi32( sum, _mm256_cmpgt_epi32( _mm256_set1_epi32( 1 -            10 ), nabs ) );
+    sum = _mm256_add_epi32( sum, _mm256_cmpgt_epi32( _mm256_set1_epi32( 1 -           100 ), nabs ) );
+    sum = _mm256_add_epi32( sum, _mm256_cmpgt_epi32( _mm256_set1_epi32( 1 -         1'000 ), nabs ) );
+    sum = _mm256_add_epi32( sum, _mm256_cmpgt_epi32( _mm256_set1_epi32( 1 -        10'000 ), nabs ) );
+    sum = _mm256_add_epi32( sum, _mm256_cmpgt_epi32( _mm256_set1_epi32( 1 -       100'000 ), nabs ) );
+    sum = _mm256_add_epi32( sum, _mm256_cmpgt_epi32( _mm256_set1_epi32( 1 -     1'000'000 ), nabs ) );
+    sum = _mm256_add_epi32( sum, _mm256_cmpgt_epi32( _mm256_set1_epi32( 1 -    10'000'000 ), nabs ) );
+    sum = _mm256_add_epi32( sum, _mm256_cmpgt_epi32( _mm256_set1_epi32( 1 -   100'000'000 ), nabs ) );
+    sum = _mm256_add_epi32( sum, _mm256_cmpgt_epi32( _mm256_set1_epi32( 1 - 1'000'000'000 ), nabs ) );
+
+    return _mm256_sub_epi32( _mm256_set1_epi32( 1 ), sum );
+}
+
+NUMDIGITS_TARGET_AVX2
+void numdigits_batch_avx2( const int32_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+{
+    // packs/packus interleave the 128-bit lanes so we need to undo that
+    const __m256i unpack = _mm256_setr_epi32( 0, 4, 1, 5, 2, 6, 3, 7 );
+
+    size_t i = 0;
+    for (; i + 32 <= nNumbers; i += 32)
+    {
+        const __m256i d0 = numdigits_avx2_epi32( _mm256_loadu_si256( (const __m256i*)(aNumbers + i +  0) ) );
+        const __m256i d1 = numdigits_avx2_epi32( _mm256_loadu_si256( (const __m256i*)(aNumbers + i +  8) ) );
+        const __m256i d2 = numdigits_avx2_epi32( _mm256_loadu_si256( (const __m256i*)(aNumbers + i + 16) ) );
+        const __m256i d3 = numdigits_avx2_epi32( _mm256_loadu_si256( (const __m256i*)(aNumbers + i + 24) ) );
+
+        const __m256i d01 = _mm256_packs_epi32 ( d0, d1 );
+        const __m256i d23 = _mm256_packs_epi32 ( d2, d3 );
+        const __m256i d03 = _mm256_packus_epi16( d01, d23 );
+        _mm256_storeu_si256( (__m256i*)(aLengths + i), _mm256_permutevar8x32_epi32( d03, unpack ) );
+    }
+    numdigits_batch_scalar( aNumbers + i, nNumbers - i, aLengths + i );
+}
+
+// 8 lanes with the conversion instead of 9 compares, see digits10_fpexp_u32().
+// cvtdq2ps is signed so we convert the -|n| fold of numdigits_avx2_epi32(), which fits for INT_MIN too,
+// and drop the sign bit of the float. 0 is folded to -1 since both have 1 digit.
+// The exponent times 1233 >> 12 is digits( 2^log2 ) - 1, and 1 - 10^digits for the fix-up compare
+// comes from two in-register tables instead of a gather.
+NUMDIGITS_TARGET_AVX2
+inline __m256i numdigits_fpexp_avx2_epi32( __m256i n )
+{
+    const __m256i pow10Lo = _mm256_setr_epi32( 1 - 10, 1 - 100, 1 - 1'000, 1 - 10'000, 1 - 100'000, 1 - 1'000'000, 1 - 10'000'000, 1 - 100'000'000 );
+    const __m256i pow10Hi = _mm256_setr_epi32( 1 - 1'000'000'000, INT32_MIN, 0, 0, 0, 0, 0, 0 ); // 10^10 doesn't fit, use a value -|n| is never below
+
+    const __m256i zero   = _mm256_setzero_si256();
+    const __m256i nabs   = _mm256_min_epi32( n, _mm256_sub_epi32( zero, n ) ); // -|n|
+    const __m256i sign   = _mm256_srai_epi32( n, 31 );                         // -1 if negative for '-'
+
+    const __m256  f      = _mm256_cvtepi32_ps( _mm256_min_epi32( nabs, _mm256_set1_epi32( -1 ) ) );
+    const __m256i exp    = _mm256_and_si256( _mm256_srli_epi32( _mm256_castps_si256( f ), 23 ), _mm256_set1_epi32( 0xFF ) );
+    const __m256i log2   = _mm256_sub_epi32( exp, _mm256_set1_epi32( 127 ) );
+    const __m256i digits = _mm256_srli_epi32( _mm256_mullo_epi32( log2, _mm256_set1_epi32( 1233 ) ), 12 ); // digits( 2^log2 ) - 1
+
+    const __m256i hi     = _mm256_cmpgt_epi32( digits, _mm256_set1_epi32( 7 ) );
+    const __m256i pow10  = _mm256_blendv_epi8( _mm256_permutevar8x32_epi32( pow10Lo, digits ), _mm256_permutevar8x32_epi32( pow10Hi, digits ), hi );
+    const __m256i above  = _mm256_cmpgt_epi32( pow10, nabs ); // -1 if |n| >= 10^(digits+1)
+
+    return _mm256_sub_epi32( _mm256_sub_epi32( _mm256_add_epi32( digits, _mm256_set1_epi32( 1 ) ), above ), sign );
+}
+
+NUMDIGITS_TARGET_AVX2
+void numdigits_batch_fpexp_avx2( const int32_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+{
+    // packs/packus interleave the 128-bit lanes so we need to undo that
+    const __m256i unpack = _mm256_setr_epi32( 0, 4, 1, 5, 2, 6, 3, 7 );
+
+    size_t i = 0;
+    for (; i + 32 <= nNumbers; i += 32)
+    {
+        const __m256i d0 = numdigits_fpexp_avx2_epi32( _mm256_loadu_si256( (const __m256i*)(aNumbers + i +  0) ) );
+        const __m256i d1 = numdigits_fpexp_avx2_epi32( _mm256_loadu_si256( (const __m256i*)(aNumbers + i +  8) ) );
+        const __m256i d2 = numdigits_fpexp_avx2_epi32( _mm256_loadu_si256( (const __m256i*)(aNumbers + i + 16) ) );
+        const __m256i d3 = numdigits_fpexp_avx2_epi32( _mm256_loadu_si256( (const __m256i*)(aNumbers + i + 24) ) );
+
+        const __m256i d01 = _mm256_packs_epi32 ( d0, d1 );
+        const __m256i d23 = _mm256_packs_epi32 ( d2, d3 );
+        const __m256i d03 = _mm256_packus_epi16( d01, d23 );
+        _mm256_storeu_si256( (__m256i*)(aLengths + i), _mm256_permutevar8x32_epi32( d03, unpack ) );
+    }
+    numdigits_batch_scalar( aNumbers + i, nNumbers - i, aLengths + i );
+}
+
+// AVX2 has no 64-bit lzcnt and no 64-bit int -> double conversion so we build one from a 32-bit high/low split:
+// The non-zero half is < 2^32, and any integer < 2^52 becomes an exact double by OR'ing it into the
+// mantissa of 2^52 and subtracting 2^52, which gives us log2() in the exponent bits.
+// The bit width estimate is the same as digits10_lzcnt() except we use (log2 * 1233) >> 12 = floor(log2 * log10(2))
+// instead of a table, and gather the Pow10_u64[] for the fix-up compare.
+// AVX2 also only has a SIGNED 64-bit compare so we flip the top bit of both sides for an unsigned compare:
+//     x < 10^k  <=>  (10^k ^ 2^63) > (x ^ 2^63)
+NUMDIGITS_TARGET_AVX2
+inline __m256i digits10_avx2_epu64( __m256i x )
+{
+    const __m256i one    = _mm256_set1_epi64x( 1 );
+    const __m256i magic  = _mm256_set1_epi64x( 0x4330000000000000ll ); // 2^52 as double
+    const __m256i bias   = _mm256_set1_epi64x( INT64_MIN );
+
+    const __m256i x1     = _mm256_or_si256( x, one ); // 0 has 1 digit, same as 1
+    const __m256i hi     = _mm256_srli_epi64( x1, 32 );
+    const __m256i lo     = _mm256_and_si256 ( x1, _mm256_set1_epi64x( 0xFFFFFFFFll ) );
+    const __m256i hiZero = _mm256_cmpeq_epi64( hi, _mm256_setzero_si256() );
+    const __m256i half   = _mm256_blendv_epi8( hi, lo, hiZero );
+
+    const __m256d d      = _mm256_sub_pd( _mm256_castsi256_pd( _mm256_or_si256( half, magic ) ), _mm256_castsi256_pd( magic ) );
+    const __m256i exp    = _mm256_srli_epi64( _mm256_castpd_si256( d ), 52 );
+    const __m256i log2   = _mm256_add_epi64( _mm256_sub_epi64( exp, _mm256_set1_epi64x( 1023 ) ), _mm256_andnot_si256( hiZero, _mm256_set1_epi64x( 32 ) ) );
+
+    const __m256i digits = _mm256_srli_epi64( _mm256_mul_epu32( log2, _mm256_set1_epi64x( 1233 ) ), 12 ); // digits( 2^log2 ) - 1
+    const __m256i pow10  = _mm256_i64gather_epi64( (const long long*) Pow10_u64.data(), digits, 8 );
+    const __m256i below  = _mm256_cmpgt_epi64( _mm256_xor_si256( pow10, bias ), _mm256_xor_si256( x1, bias ) ); // -1 if x < 10^(digits+1)
+
+    return _mm256_add_epi64( _mm256_add_epi64( digits, _mm256_set1_epi64x( 2 ) ), below );
+}
+
+// Fold to the unsigned magnitude with (n ^ sign) - sign, which turns INT64_MIN into 2^63,
+// then the sign mask adds the '-'.
+NUMDIGITS_TARGET_AVX2
+inline __m256i numdigits_avx2_epi64( __m256i n )
+{
+    const __m256i sign = _mm256_cmpgt_epi64( _mm256_setzero_si256(), n ); // -1 if negative
+    const __m256i x    = _mm256_sub_epi64( _mm256_xor_si256( n, sign ), sign );
+    return _mm256_sub_epi64( digits10_avx2_epu64( x ), sign );
+}
+
+// Narrows 16 lengths, 4 per 64-bit lane, to 16 bytes in order
+NUMDIGITS_TARGET_AVX2
+inline void numdigits_avx2_store16_epi64( uint8_t *aLengths, __m256i d0, __m256i d1, __m256i d2, __m256i d3 )
+{
+    const __m256i even = _mm256_setr_epi32( 0, 2, 4, 6, 0, 2, 4, 6 );
+
+    const __m128i q0 = _mm256_castsi256_si128( _mm256_permutevar8x32_epi32( d0, even ) );
+    const __m128i q1 = _mm256_castsi256_si128( _mm256_permutevar8x32_epi32( d1, even ) );
+    const __m128i q2 = _mm256_castsi256_si128( _mm256_permutevar8x32_epi32( d2, even ) );
+    const __m128i q3 = _mm256_castsi256_si128( _mm256_permutevar8x32_epi32( d3, even ) );
+
+    const __m128i q01 = _mm_packs_epi32 ( q0, q1 );
+    const __m128i q23 = _mm_packs_epi32 ( q2, q3 );
+    _mm_storeu_si128( (__m128i*) aLengths, _mm_packus_epi16( q01, q23 ) );
+}
+
+NUMDIGITS_TARGET_AVX2
+void numdigits_batch_i64_avx2( const int64_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+{
+    size_t i = 0;
+    for (; i + 16 <= nNumbers; i += 16)
+    {
+        const __m256i d0 = numdigits_avx2_epi64( _mm256_loadu_si256( (const __m256i*)(aNumbers + i +  0) ) );
+        const __m256i d1 = numdigits_avx2_epi64( _mm256_loadu_si256( (const __m256i*)(aNumbers + i +  4) ) );
+        const __m256i d2 = numdigits_avx2_epi64( _mm256_loadu_si256( (const __m256i*)(aNumbers + i +  8) ) );
+        const __m256i d3 = numdigits_avx2_epi64( _mm256_loadu_si256( (const __m256i*)(aNumbers + i + 12) ) );
+        numdigits_avx2_store16_epi64( aLengths + i, d0, d1, d2, d3 );
+    }
+    numdigits_batch_i64_scalar( aNumbers + i, nNumbers - i, aLengths + i );
+}
+
+NUMDIGITS_TARGET_AVX2
+void digits10_batch_u64_avx2( const uint64_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+{
+    size_t i = 0;
+    for (; i + 16 <= nNumbers; i += 16)
+    {
+        const __m256i d0 = digits10_avx2_epu64( _mm256_loadu_si256( (const __m256i*)(aNumbers + i +  0) ) );
+        const __m256i d1 = digits10_avx2_epu64( _mm256_loadu_si256( (const __m256i*)(aNumbers + i +  4) ) );
+        const __m256i d2 = digits10_avx2_epu64( _mm256_loadu_si256( (const __m256i*)(aNumbers + i +  8) ) );
+        const __m256i d3 = digits10_avx2_epu64( _mm256_loadu_si256( (const __m256i*)(aNumbers + i + 12) ) );
+        numdigits_avx2_store16_epi64( aLengths + i, d0, d1, d2, d3 );
+    }
+    digits10_batch_u64_scalar( aNumbers + i, nNumbers - i, aLengths + i );
+}
+
+// 16 lanes at once.
+// AVX-512 CD has a per-lane lzcnt so this is digits10_lzcnt_u32() with both tables held in registers:
+// 32 leading zero counts need two registers for the minimum digits, and 10^digits fits in one.
+// AVX-512 also has unsigned compares so abs(INT_MIN) = 2^31 works as is.
+NUMDIGITS_TARGET_AVX512
+inline __m128i numdigits_avx512_epi32( __m512i n )
+{
+    const __m512i one      = _mm512_set1_epi32( 1 );
+    const __m512i digitsLo = _mm512_setr_epi32( 10, 10,  9,  9,  9,  8,  8,  8,  7,  7,  7,  7,  6,  6,  6,  5 ); // lzcnt  0 .. 15
+    const __m512i digitsHi = _mm512_setr_epi32(  5,  5,  4,  4,  4,  4,  3,  3,  3,  2,  2,  2,  1,  1,  1,  1 ); // lzcnt 16 .. 31
+    const __m512i pow10    = _mm512_setr_epi32( 1, 10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000, 1'000'000'000
+                                              , -1, -1, -1, -1, -1, -1 ); // 10^10 doesn't fit, use a value |n| never reaches
+
+    // The maskz forms with all lanes on are the same instructions but avoid a bogus GCC 12
+    // -Wmaybe-uninitialized from the _mm512_undefined_epi32() the unmasked forms pass through
+    const __mmask16 all    = 0xFFFF;
+    const __m512i x        = _mm512_maskz_abs_epi32( all, n );
+    const __m512i lz       = _mm512_lzcnt_epi32( _mm512_or_si512( x, one ) );
+    const __m512i digits   = _mm512_permutex2var_epi32( digitsLo, lz, digitsHi );
+    const __m512i pow      = _mm512_maskz_permutexvar_epi32( all, digits, pow10 );
+
+    __m512i len = _mm512_mask_add_epi32( digits, _mm512_cmpge_epu32_mask( x, pow ), digits, one );
+    len = _mm512_mask_add_epi32( len, _mm512_cmplt_epi32_mask( n, _mm512_setzero_si512() ), len, one );
+    return _mm512_maskz_cvtepi32_epi8( all, len );
+}
+
+NUMDIGITS_TARGET_AVX512
+void numdigits_batch_avx512( const int32_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+{
+    size_t i = 0;
+    for (; i + 16 <= nNumbers; i += 16)
+        _mm_storeu_si128( (__m128i*)(aLengths + i), numdigits_avx512_epi32( _mm512_loadu_si512( aNumbers + i ) ) );
+    numdigits_batch_scalar( aNumbers + i, nNumbers - i, aLengths + i );
+}
+#endif // NUMDIGITS_X86
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Reduce: total formatted length, maximum length and length histogram in one pass
+//     void numdigits_reduce_*( const int32_t *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+// For presizing a buffer or padding a table we only need the aggregates, not the lengths.
+// The results are added to stats so chunks can be reduced one after another.
+
+struct NumDigitsStats
+{
+    uint64_t Total;            // Sum of the lengths, i.e. the formatted size without delimiters
+    uint64_t Histogram[ 21 ];  // [length] = count, 1 .. 11 for int, 1 .. 20 for int64_t
+    uint32_t Max;              // Longest length, 0 if there were no numbers
+};
+
+typedef void (*NumDigitsReduceFuncPtr   )( const int32_t *, size_t, NumDigitsStats& );
+typedef void (*NumDigitsReduceI64FuncPtr)( const int64_t *, size_t, NumDigitsStats& );
+
+void numdigits_stats_merge( NumDigitsStats& stats, const NumDigitsStats& other )
+{
+    stats.Total += other.Total;
+    for (int length = 0; length < 21; length++)
+        stats.Histogram[ length ] += other.Histogram[ length ];
+    stats.Max = std::max( stats.Max, other.Max );
+}
+
+// aHistogram[ length ] = count of numbers with that length
+void numdigits_stats_add( NumDigitsStats& stats, const uint64_t *aHistogram, uint32_t maxLength )
+{
+    for (uint32_t length = 1; length <= maxLength; length++)
+    {
+        stats.Histogram[ length ] += aHistogram[ length ];
+        stats.Total               += aHistogram[ length ] * length;
+        if (aHistogram[ length ] && (stats.Max < length))
+            stats.Max = length;
+    }
+}
+
+// 4 histograms so back to back numbers with the same length don't serialize on one counter
+template <typename T, uint32_t MAX_LENGTH, typename Func>
+void numdigits_reduce_scalar_impl( const T *aNumbers, size_t nNumbers, NumDigitsStats& stats, Func func )
+{
+    uint64_t aHistogram[ 4 ][ MAX_LENGTH + 1 ] = {};
+    size_t i = 0;
+    for (; i + 4 <= nNumbers; i += 4)
+    {
+        aHistogram[0][ func( aNumbers[ i+0 ] ) ]++;
+        aHistogram[1][ func( aNumbers[ i+1 ] ) ]++;
+        aHistogram[2][ func( aNumbers[ i+2 ] ) ]++;
+        aHistogram[3][ func( aNumbers[ i+3 ] ) ]++;
+    }
+    for (; i < nNumbers; i++)
+        aHistogram[0][ func( aNumbers[ i ] ) ]++;
+
+    for (uint32_t length = 1; length <= MAX_LENGTH; length++)
+        aHistogram[0][ length ] += aHistogram[1][ length ] + aHistogram[2][ length ] + aHistogram[3][ length ];
+    numdigits_stats_add( stats, aHistogram[0], MAX_LENGTH );
+}
+
+void numdigits_reduce_scalar( const int32_t *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+{
+    numdigits_reduce_scalar_impl<int32_t, 11>( aNumbers, nNumbers, stats, numdigits_lzcnt );
+}
+
+void numdigits_reduce_i64_scalar( const int64_t *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+{
+    numdigits_reduce_scalar_impl<int64_t, 20>( aNumbers, nNumbers, stats, numdigits_lzcnt_int64 );
+}
+
+void digits10_reduce_u64_scalar( const uint64_t *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+{
+    numdigits_reduce_scalar_impl<uint64_t, 20>( aNumbers, nNumbers, stats, digits10_lzcnt );
+}
+
+#if NUMDIGITS_X86
+// The lengths of 32 numbers are packed into the bytes of one register, in any order since we only count them.
+// For every j we count the lengths > j with a byte compare, then
+//     histogram[ j ] = count( length > j - 1 ) - count( length > j )
+// The byte counters would overflow after 255 registers so each block of 255 is widened to 64-bit with SAD.
+// The total length comes from the histogram in numdigits_stats_add().
+// lengths32( aNumbers + i ) returns the packed lengths of the 32 numbers at i.
+// The j loops must be unrolled to keep the counters in registers.
+#if defined(__GNUC__)
+    #define NUMDIGITS_UNROLL _Pragma("GCC unroll 20")
+#else
+    #define NUMDIGITS_UNROLL
+#endif
+
+template <uint32_t MAX_LENGTH, typename T, __m256i (*lengths32)( const T* )>
+NUMDIGITS_TARGET_AVX2
+inline size_t numdigits_reduce_avx2_impl( const T *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i above64[ MAX_LENGTH ]; // [j] = count( length > j ), j = 1 .. MAX_LENGTH - 1
+    for (uint32_t j = 1; j < MAX_LENGTH; j++)
+        above64[ j ] = zero;
+
+    size_t i = 0;
+    while (i + 32 <= nNumbers)
+    {
+        __m256i above8[ MAX_LENGTH ];
+        NUMDIGITS_UNROLL
+        for (uint32_t j = 1; j < MAX_LENGTH; j++)
+            above8[ j ] = zero;
+
+        const size_t iEnd = std::min( nNumbers & ~(size_t)31, i + 255*32 );
+        for (; i < iEnd; i += 32)
+        {
+            const __m256i lengths = lengths32( aNumbers + i );
+            NUMDIGITS_UNROLL
+            for (uint32_t j = 1; j < MAX_LENGTH; j++)
+                above8[ j ] = _mm256_sub_epi8( above8[ j ], _mm256_cmpgt_epi8( lengths, _mm256_set1_epi8( (char) j ) ) );
+        }
+
+        NUMDIGITS_UNROLL
+        for (uint32_t j = 1; j < MAX_LENGTH; j++)
+            above64[ j ] = _mm256_add_epi64( above64[ j ], _mm256_sad_epu8( above8[ j ], zero ) );
+    }
+
+    uint64_t aAbove[ MAX_LENGTH + 1 ] = {};
+    aAbove[ 0 ] = i;
+    for (uint32_t j = 1; j < MAX_LENGTH; j++)
+    {
+        alignas(32) uint64_t lanes[ 4 ];
+        _mm256_store_si256( (__m256i*) lanes, above64[ j ] );
+        aAbove[ j ] = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+
+    uint64_t aHistogram[ MAX_LENGTH + 1 ] = {};
+    for (uint32_t length = 1; length <= MAX_LENGTH; length++)
+        aHistogram[ length ] = aAbove[ length - 1 ] - aAbove[ length ];
+    numdigits_stats_add( stats, aHistogram, MAX_LENGTH );
+    return i;
+}
+
+// Unlike numdigits_batch_avx2() the interleaved order of packs/packus doesn't matter
+NUMDIGITS_TARGET_AVX2
+inline __m256i numdigits_avx2_lengths32_epi32( const int32_t *p )
+{
+    const __m256i d0 = numdigits_avx2_epi32( _mm256_loadu_si256( (const __m256i*)(p +  0) ) );
+    const __m256i d1 = numdigits_avx2_epi32( _mm256_loadu_si256( (const __m256i*)(p +  8) ) );
+    const __m256i d2 = numdigits_avx2_epi32( _mm256_loadu_si256( (const __m256i*)(p + 16) ) );
+    const __m256i d3 = numdigits_avx2_epi32( _mm256_loadu_si256( (const __m256i*)(p + 24) ) );
+    return _mm256_packus_epi16( _mm256_packs_epi32( d0, d1 ), _mm256_packs_epi32( d2, d3 ) );
+}
+
+// The 64-bit lengths are < 2^32 so pairs of registers are merged into 32-bit lanes with a shift before packing
+NUMDIGITS_TARGET_AVX2
+inline __m256i numdigits_avx2_lengths32_epi64( const int64_t *p )
+{
+    __m256i d[ 8 ];
+    for (int j = 0; j < 8; j++)
+        d[ j ] = numdigits_avx2_epi64( _mm256_loadu_si256( (const __m256i*)(p + 4*j) ) );
+
+    const __m256i d01 = _mm256_or_si256( d[0], _mm256_slli_epi64( d[1], 32 ) );
+    const __m256i d23 = _mm256_or_si256( d[2], _mm256_slli_epi64( d[3], 32 ) );
+    const __m256i d45 = _mm256_or_si256( d[4], _mm256_slli_epi64( d[5], 32 ) );
+    const __m256i d67 = _mm256_or_si256( d[6], _mm256_slli_epi64( d[7], 32 ) );
+    return _mm256_packus_epi16( _mm256_packs_epi32( d01, d23 ), _mm256_packs_epi32( d45, d67 ) );
+}
+
+NUMDIGITS_TARGET_AVX2
+void numdigits_reduce_avx2( const int32_t *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+{
+    const size_t i = numdigits_reduce_avx2_impl<11, int32_t, numdigits_avx2_lengths32_epi32>( aNumbers, nNumbers, stats );
+    numdigits_reduce_scalar( aNumbers + i, nNumbers - i, stats );
+}
+
+NUMDIGITS_TARGET_AVX2
+void numdigits_reduce_i64_avx2( const int64_t *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+{
+    const size_t i = numdigits_reduce_avx2_impl<20, int64_t, numdigits_avx2_lengths32_epi64>( aNumbers, nNumbers, stats );
+    numdigits_reduce_i64_scalar( aNumbers + i, nNumbers - i, stats );
+}
+#endif // NUMDIGITS_X86
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Sorted: lengths of an ascending uint64_t column such as row ids, timestamps or offsets
+//     void digits10_batch_u64_sorted ( const uint64_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+//     void digits10_reduce_u64_sorted( const uint64_t *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+// In a sorted column the length only changes at the first number >= 10^k, so at most 19 times.
+// Each change is a binary search of the rest of the column: O(19 log n) instead of O(n) counts.
+// The histogram never reads the numbers in between, and the lengths are filled one run at a time with memset().
+// The _sorted versions trust the caller; unsorted input gives wrong lengths.
+// The _if_sorted versions check the order first, one compare per number but stopping at the first
+// number out of order, and otherwise count every number like the generic batch.
+
+#include <string.h> // memset()
+
+// Calls run( length, iBegin, iEnd ) for each run of numbers with the same length, shortest first. Runs can be empty.
+template <typename Func>
+inline void digits10_sorted_runs( const uint64_t *aNumbers, size_t nNumbers, Func run )
+{
+    if (!nNumbers)
+        return;
+
+    const uint32_t last   = digits10_lzcnt( aNumbers[ nNumbers - 1 ] );
+    size_t         iBegin = 0;
+    for (uint32_t length = digits10_lzcnt( aNumbers[ 0 ] ); length < last; length++)
+    {
+        // First number with length + 1 digits
+        const size_t iEnd = std::lower_bound( aNumbers + iBegin, aNumbers + nNumbers, Pow10_constexpr[ length ] ) - aNumbers;
+        run( length, iBegin, iEnd );
+        iBegin = iEnd;
+    }
+    run( last, iBegin, nNumbers );
+}
+
+void digits10_batch_u64_sorted( const uint64_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+{
+    digits10_sorted_runs( aNumbers, nNumbers, [aLengths]( uint32_t length, size_t iBegin, size_t iEnd ) {
+        memset( aLengths + iBegin, (int) length, iEnd - iBegin );
+    });
+}
+
+void digits10_reduce_u64_sorted( const uint64_t *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+{
+    uint64_t aHistogram[ 21 ] = {};
+    digits10_sorted_runs( aNumbers, nNumbers, [&aHistogram]( uint32_t length, size_t iBegin, size_t iEnd ) {
+        aHistogram[ length ] += iEnd - iBegin;
+    });
+    numdigits_stats_add( stats, aHistogram, 20 );
+}
+
+void digits10_batch_u64_if_sorted( const uint64_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+{
+    if (std::is_sorted( aNumbers, aNumbers + nNumbers ))
+        digits10_batch_u64_sorted( aNumbers, nNumbers, aLengths );
+    else
+        digits10_batch_u64_scalar( aNumbers, nNumbers, aLengths );
+}
+
+void digits10_reduce_u64_if_sorted( const uint64_t *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+{
+    if (std::is_sorted( aNumbers, aNumbers + nNumbers ))
+        digits10_reduce_u64_sorted( aNumbers, nNumbers, stats );
+    else
+        digits10_reduce_u64_scalar( aNumbers, nNumbers, stats );
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Dispatch: one binary for every CPU generation.
+// The fastest variant for this CPU is resolved once at startup from cpuid and called through a function pointer.
+//     int         numdigits_count        ( int n )
+//     void        numdigits_count_batch  ( const int32_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+//     void        numdigits_count_reduce    ( const int32_t *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+//     void        numdigits_count_reduce_i64( const int64_t *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+//     const char* numdigits_count_variant()          // "scalar / batch / reduce", e.g. "lzcnt / avx512 / avx2"
+//     const char* numdigits_count_variant_scalar()   // the kernel numdigits_count() runs, e.g. "lzcnt"
+
+#include <stdio.h> // snprintf()
+
+struct NumDigitsDispatch
+{
+    int                     (*Count)( int );
+    NumDigitsBatchFuncPtr     CountBatch;
+    NumDigitsReduceFuncPtr    Reduce;
+    NumDigitsReduceI64FuncPtr ReduceI64;
+    const char               *CountVariant;
+    const char               *BatchVariant;
+    const char               *ReduceVariant;
+    char                      Variant[ 48 ];
+};
+
+NumDigitsDispatch numdigits_dispatch_resolve( int features )
+{
+    // The fastest single int version differs per architecture, see README
+#if NUMDIGITS_X86
+    NumDigitsDispatch dispatch = { numdigits_alexandrescu_pohoreski_v3, numdigits_batch_scalar, numdigits_reduce_scalar, numdigits_reduce_i64_scalar, "alexandrescu_pohoreski_v3", "scalar", "scalar", "" };
+    if (features & NUMDIGITS_CPU_LZCNT) {
+        dispatch.Count        = numdigits_lzcnt_hw;
+        dispatch.CountVariant = "lzcnt";
+    }
+
+    // The histogram needs byte compares so AVX-512 F/CD without BW stays on AVX2
+    if (features & NUMDIGITS_CPU_AVX2) {
+        dispatch.Reduce        = numdigits_reduce_avx2;
+        dispatch.ReduceI64     = numdigits_reduce_i64_avx2;
+        dispatch.ReduceVariant = "avx2";
+    }
+
+    if (features & NUMDIGITS_CPU_AVX512) {
+        dispatch.CountBatch   = numdigits_batch_avx512;
+        dispatch.BatchVariant = "avx512";
+    }
+    else
+    if (features & NUMDIGITS_CPU_AVX2) {
+        dispatch.CountBatch   = numdigits_batch_avx2;
+        dispatch.BatchVariant = "avx2";
+    }
+    else
+    if (features & NUMDIGITS_CPU_SSE41) {
+        dispatch.CountBatch   = numdigits_batch_sse41;
+        dispatch.BatchVariant = "sse4.1";
+    }
+#else
+    (void) features;
+    NumDigitsDispatch dispatch = { numdigits_simple, numdigits_batch_scalar, numdigits_reduce_scalar, numdigits_reduce_i64_scalar, "simple", "scalar", "scalar", "" };
+#endif
+    snprintf( dispatch.Variant, sizeof(dispatch.Variant), "%s / %s / %s", dispatch.CountVariant, dispatch.BatchVariant, dispatch.ReduceVariant );
+    return dispatch;
+}
+
+static const NumDigitsDispatch g_NumDigitsDispatch = numdigits_dispatch_resolve( cpu_features() );
+
+int numdigits_count( int n )
+{
+    return g_NumDigitsDispatch.Count( n );
+}
+
+void numdigits_count_batch( const int32_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+{
+    g_NumDigitsDispatch.CountBatch( aNumbers, nNumbers, aLengths );
+}
+
+void numdigits_count_reduce( const int32_t *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+{
+    g_NumDigitsDispatch.Reduce( aNumbers, nNumbers, stats );
+}
+
+void numdigits_count_reduce_i64( const int64_t *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+{
+    g_NumDigitsDispatch.ReduceI64( aNumbers, nNumbers, stats );
+}
+
+const char* numdigits_count_variant()
+{
+    return g_NumDigitsDispatch.Variant;
+}
+
+const char* numdigits_count_variant_scalar()
+{
+    return g_NumDigitsDispatch.CountVariant;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Tuned: the fastest implementation measured on this host
+//     numdigits_benchmark -autotune=numdigits_tuned.h
+//     g++ -DNUMDIGITS_TUNED_HEADER='"numdigits_tuned.h"' ...
+// Without a tuned header these fall back to the dispatch.
+#ifdef NUMDIGITS_TUNED_HEADER
+    #include NUMDIGITS_TUNED_HEADER
+#else
+    #define NUMDIGITS_TUNED 0
+    inline int      numdigits_best_int( int      n ) { return numdigits_count( n ); }
+    inline uint32_t numdigits_best_u64( uint64_t n ) { return digits10_lzcnt( n ); }
+#endif
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Column serializer: a whole int array as delimited text, byte-identical to printf( "%d," ) per number
+//     std::vector<char> text;
+//     numdigits_serialize( aNumbers, nNumbers, ',', text );
+// 1. numdigits_count_batch() gives every length
+// 2. an exclusive prefix sum of length + delimiter gives every offset and the exact total size
+// 3. every number is written backwards from its end offset straight into the one buffer
+// Since the offsets are known up front each number can be written independently with no bounds checks.
+
+// aOffsets[i] = start of number i; returns the total size in bytes
+size_t numdigits_serialize_offsets( const uint8_t *aLengths, size_t nNumbers, size_t *aOffsets )
+{
+    size_t offset = 0;
+    for (size_t i = 0; i < nNumbers; i++)
+    {
+        aOffsets[ i ] = offset;
+        offset += aLengths[ i ] + 1; // + delimiter
+    }
+    return offset;
+}
+
+// pText needs room for the total returned by numdigits_serialize_offsets()
+void numdigits_serialize_write( const int32_t *aNumbers, size_t nNumbers, const uint8_t *aLengths, const size_t *aOffsets, char *pText, char delimiter )
+{
+    for (size_t i = 0; i < nNumbers; i++)
+    {
+        const int32_t  n    = aNumbers[ i ];
+        const uint32_t x    = (n < 0) ? 0u - (uint32_t)n : (uint32_t)n;
+        char          *pBeg = pText + aOffsets[ i ];
+        char          *pEnd = pBeg  + aLengths[ i ];
+        pBeg[0] = '-'; // overwritten by the first digit if positive
+        digits10_write_backwards_u32( pEnd, x );
+        pEnd[0] = delimiter;
+    }
+}
+
+// Returns the number of bytes written; text is resized exactly once
+size_t numdigits_serialize( const int32_t *aNumbers, size_t nNumbers, char delimiter, std::vector<char>& text )
+{
+    std::vector<uint8_t> lengths( nNumbers );
+    std::vector<size_t>  offsets( nNumbers );
+
+    numdigits_count_batch( aNumbers, nNumbers, lengths.data() );
+    const size_t size = numdigits_serialize_offsets( lengths.data(), nNumbers, offsets.data() );
+
+    text.resize( size );
+    numdigits_serialize_write( aNumbers, nNumbers, lengths.data(), offsets.data(), text.data(), delimiter );
+    return size;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Parallel: total formatted length and length histogram of arrays too big for one core
+//     NumDigitsStats stats = numdigits_parallel_stats( aNumbers, nNumbers ); // all cores
+// The array is split into cache-sized chunks that the threads grab from a shared counter
+// so a slow or preempted thread just takes fewer chunks. Each chunk runs numdigits_count_reduce()
+// so the lengths are never written to memory.
+#include <atomic>
+#include <thread>
+
+#define NUMDIGITS_PARALLEL_CHUNK 16384 // 64 KB of int fits in L2
+
+// nThreads = 0 uses every hardware thread
+NumDigitsStats numdigits_parallel_stats( const int32_t *aNumbers, size_t nNumbers, unsigned nThreads = 0 )
+{
+    if (!nThreads)
+        nThreads = std::max( 1u, std::thread::hardware_concurrency() );
+
+    const size_t nChunks = (nNumbers + NUMDIGITS_PARALLEL_CHUNK - 1) / NUMDIGITS_PARALLEL_CHUNK;
+    nThreads = (unsigned) std::min( (size_t)nThreads, std::max( nChunks, (size_t)1 ) );
+
+    std::atomic<size_t>         nextChunk( 0 );
+    std::vector<NumDigitsStats> aStats( nThreads, NumDigitsStats{} );
+
+    auto worker = [&]( unsigned iThread )
+    {
+        NumDigitsStats& stats = aStats[ iThread ];
+        for (size_t iChunk = nextChunk++; iChunk < nChunks; iChunk = nextChunk++)
+        {
+            const size_t iBegin = iChunk * NUMDIGITS_PARALLEL_CHUNK;
+            const size_t nCount = std::min( (size_t)NUMDIGITS_PARALLEL_CHUNK, nNumbers - iBegin );
+            numdigits_count_reduce( aNumbers + iBegin, nCount, stats );
+        }
+    };
+
+    // The calling thread is worker 0
+    std::vector<std::thread> aThreads;
+    for (unsigned iThread = 1; iThread < nThreads; iThread++)
+        aThreads.emplace_back( worker, iThread );
+    worker( 0 );
+    for (std::thread& thread : aThreads)
+        thread.join();
+
+    NumDigitsStats stats = {};
+    for (const NumDigitsStats& other : aStats)
+        numdigits_stats_merge( stats, other );
+    return stats;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Adaptive: numdigits_adaptive( n ) picks its kernel from the lengths of the numbers it has seen
+//     int         numdigits_adaptive         ( int n )
+//     const char* numdigits_adaptive_variant ()
+//     uint32_t    numdigits_adaptive_switches()
+// Each call adds one entry from a table to a per-thread 64-bit counter that packs the number of calls and
+// a 3 bucket histogram, so sampling is a single add. Every NUMDIGITS_ADAPTIVE_PERIOD calls the histogram
+// picks the kernel for everyone through an atomic function pointer:
+//     7/8 or more 1 .. 4 digits   -> ladder from small, numdigits_pohoreski_v3b()
+//     7/8 or more 9 .. 10 digits  -> ladder from large, numdigits_simple_reverse32()
+//     anything else               -> branchless table, numdigits_lzcnt()
+// A ladder can only win while its exit is both near the top and predictable, hence the 7/8 threshold,
+// but whether it does depends on the host. The first retune times each ladder against the branchless kernel
+// on that ladder's own inputs and a ladder is only ever chosen if it was at least 2% faster.
+// See numdigits_benchmark -adaptive for the cost of sampling and switching when the distribution shifts.
+
+#include <chrono>
+
+#ifndef NUMDIGITS_ADAPTIVE_PERIOD
+#define NUMDIGITS_ADAPTIVE_PERIOD 4096 // calls between decisions, < 2^21
+#endif
+
+#define NUMDIGITS_ADAPTIVE_CALLS_SHIFT  0
+#define NUMDIGITS_ADAPTIVE_SMALL_SHIFT 21
+#define NUMDIGITS_ADAPTIVE_LARGE_SHIFT 42
+#define NUMDIGITS_ADAPTIVE_FIELD_MASK  0x1FFFFFull
+
+enum NumDigitsAdaptive_e
+{
+      NUMDIGITS_ADAPTIVE_SMALL
+    , NUMDIGITS_ADAPTIVE_LARGE
+    , NUMDIGITS_ADAPTIVE_BRANCHLESS
+    , NUM_NUMDIGITS_ADAPTIVE
+};
+
+struct NumDigitsAdaptiveKernel
+{
+    int       (*pFunc)( int );
+    const char *pName;
+};
+
+const NumDigitsAdaptiveKernel NumDigits_Adaptive_Kernels[ NUM_NUMDIGITS_ADAPTIVE ] =
+{
+      { numdigits_pohoreski_v3b   , "ladder_small" }
+    , { numdigits_simple_reverse32, "ladder_large" }
+    , { numdigits_lzcnt           , "branchless"   }
+};
+
+// [digits of |n|] = 1 call + 1 small or large
+const uint64_t NumDigits_Adaptive_Increment[ 11 ] =
+{
+      0
+    , (1ull << NUMDIGITS_ADAPTIVE_CALLS_SHIFT) + (1ull << NUMDIGITS_ADAPTIVE_SMALL_SHIFT) // [ 1]
+    , (1ull << NUMDIGITS_ADAPTIVE_CALLS_SHIFT) + (1ull << NUMDIGITS_ADAPTIVE_SMALL_SHIFT) // [ 2]
+    , (1ull << NUMDIGITS_ADAPTIVE_CALLS_SHIFT) + (1ull << NUMDIGITS_ADAPTIVE_SMALL_SHIFT) // [ 3]
+    , (1ull << NUMDIGITS_ADAPTIVE_CALLS_SHIFT) + (1ull << NUMDIGITS_ADAPTIVE_SMALL_SHIFT) // [ 4]
+    , (1ull << NUMDIGITS_ADAPTIVE_CALLS_SHIFT)                                            // [ 5]
+    , (1ull << NUMDIGITS_ADAPTIVE_CALLS_SHIFT)                                            // [ 6]
+    , (1ull << NUMDIGITS_ADAPTIVE_CALLS_SHIFT)                                            // [ 7]
+    , (1ull << NUMDIGITS_ADAPTIVE_CALLS_SHIFT)                                            // [ 8]
+    , (1ull << NUMDIGITS_ADAPTIVE_CALLS_SHIFT) + (1ull << NUMDIGITS_ADAPTIVE_LARGE_SHIFT) // [ 9]
+    , (1ull << NUMDIGITS_ADAPTIVE_CALLS_SHIFT) + (1ull << NUMDIGITS_ADAPTIVE_LARGE_SHIFT) // [10]
+};
+
+static std::atomic<int (*)( int )> g_NumDigitsAdaptiveFunc    { numdigits_lzcnt };
+static std::atomic<uint32_t>       g_NumDigitsAdaptiveSwitches{ 0 };
+static thread_local uint64_t t_NumDigitsAdaptiveSampler;
+
+// ns per call of a ladder and of the branchless kernel on the ladder's inputs, best of 8 passes
+struct NumDigitsAdaptiveCalibration
+{
+    double LadderNS    [ NUMDIGITS_ADAPTIVE_BRANCHLESS ]; // [NUMDIGITS_ADAPTIVE_SMALL or _LARGE]
+    double BranchlessNS[ NUMDIGITS_ADAPTIVE_BRANCHLESS ];
+    bool   LadderWins  [ NUMDIGITS_ADAPTIVE_BRANCHLESS ];
+};
+
+// Both called through a volatile pointer like the atomic one so neither is inlined into the loop
+inline double numdigits_adaptive_time( int (* volatile pFunc)( int ), const std::vector<int>& numbers )
+{
+    double best = 1e300;
+    for (int iPass = 0; iPass < 8; iPass++)
+    {
+        int (*pCall)( int ) = pFunc;
+        int sum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int n : numbers)
+            sum += pCall( n );
+        const auto stop  = std::chrono::steady_clock::now();
+        volatile int sink = sum; // keeps the calls
+        (void) sink;
+        best = std::min( best, std::chrono::duration<double, std::nano>( stop - start ).count() / numbers.size() );
+    }
+    return best;
+}
+
+// Measured once, on the first retune of any thread
+const NumDigitsAdaptiveCalibration& numdigits_adaptive_calibration()
+{
+    struct Calibrator
+    {
+        NumDigitsAdaptiveCalibration Result;
+        Calibrator()
+        {
+            const struct { uint32_t nMin; uint32_t nMax; } aRanges[ NUMDIGITS_ADAPTIVE_BRANCHLESS ] = {
+                  {             0,     9'999 } // NUMDIGITS_ADAPTIVE_SMALL
+                , { 1'000'000'000, INT32_MAX } // NUMDIGITS_ADAPTIVE_LARGE
+            };
+            uint64_t seed = 1;
+            for (int iLadder = 0; iLadder < NUMDIGITS_ADAPTIVE_BRANCHLESS; iLadder++)
+            {
+                std::vector<int> numbers( NUMDIGITS_ADAPTIVE_PERIOD );
+                for (int& n : numbers)
+                {
+                    seed = seed * 6364136223846793005ull + 1442695040888963407ull; // LCG
+                    const uint32_t r = (uint32_t)(seed >> 32);
+                    n = (int)(aRanges[ iLadder ].nMin + r % (aRanges[ iLadder ].nMax - aRanges[ iLadder ].nMin + 1));
+                    if (seed & 0x80000000u)
+                        n = -n;
+                }
+                Result.LadderNS    [ iLadder ] = numdigits_adaptive_time( NumDigits_Adaptive_Kernels[ iLadder                      ].pFunc, numbers );
+                Result.BranchlessNS[ iLadder ] = numdigits_adaptive_time( NumDigits_Adaptive_Kernels[ NUMDIGITS_ADAPTIVE_BRANCHLESS ].pFunc, numbers );
+                Result.LadderWins  [ iLadder ] = Result.LadderNS[ iLadder ] * 1.02 < Result.BranchlessNS[ iLadder ]; // a tie in the noise keeps branchless
+            }
+        }
+    };
+    static const Calibrator calibrator; // thread-safe initialization
+    return calibrator.Result;
+}
+
+int numdigits_adaptive_choose( uint64_t sampler )
+{
+    const NumDigitsAdaptiveCalibration& calibration = numdigits_adaptive_calibration();
+    const uint64_t calls = (sampler >> NUMDIGITS_ADAPTIVE_CALLS_SHIFT) & NUMDIGITS_ADAPTIVE_FIELD_MASK;
+    const uint64_t small = (sampler >> NUMDIGITS_ADAPTIVE_SMALL_SHIFT) & NUMDIGITS_ADAPTIVE_FIELD_MASK;
+    const uint64_t large = (sampler >> NUMDIGITS_ADAPTIVE_LARGE_SHIFT) & NUMDIGITS_ADAPTIVE_FIELD_MASK;
+    if ((small >= calls - calls / 8) && calibration.LadderWins[ NUMDIGITS_ADAPTIVE_SMALL ]) return NUMDIGITS_ADAPTIVE_SMALL;
+    if ((large >= calls - calls / 8) && calibration.LadderWins[ NUMDIGITS_ADAPTIVE_LARGE ]) return NUMDIGITS_ADAPTIVE_LARGE;
+    return NUMDIGITS_ADAPTIVE_BRANCHLESS;
+}
+
+// Out of line so the per call path stays small
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void numdigits_adaptive_retune( uint64_t& sampler )
+{
+    int (*pFunc)( int ) = NumDigits_Adaptive_Kernels[ numdigits_adaptive_choose( sampler ) ].pFunc;
+    if (g_NumDigitsAdaptiveFunc.exchange( pFunc, std::memory_order_relaxed ) != pFunc)
+        g_NumDigitsAdaptiveSwitches.fetch_add( 1, std::memory_order_relaxed );
+    sampler = 0;
+}
+
+int numdigits_adaptive( int n )
+{
+    const int digits = g_NumDigitsAdaptiveFunc.load( std::memory_order_relaxed )( n );
+
+    uint64_t& sampler = t_NumDigitsAdaptiveSampler;
+    sampler += NumDigits_Adaptive_Increment[ digits - (n < 0) ];
+    if ((sampler & NUMDIGITS_ADAPTIVE_FIELD_MASK) == NUMDIGITS_ADAPTIVE_PERIOD)
+        numdigits_adaptive_retune( sampler );
+    return digits;
+}
+
+const char* numdigits_adaptive_variant()
+{
+    int (*pFunc)( int ) = g_NumDigitsAdaptiveFunc.load( std::memory_order_relaxed );
+    for (const NumDigitsAdaptiveKernel& kernel : NumDigits_Adaptive_Kernels)
+        if (kernel.pFunc == pFunc)
+            return kernel.pName;
+    return "?";
+}
+
+uint32_t numdigits_adaptive_switches()
+{
+    return g_NumDigitsAdaptiveSwitches.load( std::memory_order_relaxed );
+}
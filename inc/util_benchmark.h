@@ -1,4 +1,6 @@
 /*
+// v1.10 Add BENCHMARK_DYNAMIC(name,func) to register a benchmark whose name is built at run time
+// v1.9 Add BENCHMARK_REFERENCE(name) to start a new group of results; %faster, the ranking and the auto-detect of broken implementations are per group
 // v1.8 Add support to flag broken implementations with BENCHMARK_2(name,false) and not include them in the ranking
 // v1.7 Add -? usage help and examples
 // v1.6 Add -markdown command-line argument, pretty print support (markdown table and rank in best)
@@ -21,6 +23,7 @@ https://google.github.io/benchmark/user_guide.html
     #include <numeric>    // iota()
     #include <chrono>
     #include <vector>
+    #include <string>     // BENCHMARK_DYNAMIC() names
 
 #define BENCHMARK_SAMPLE_SIZE 1000000
 #if _DEBUG
@@ -87,11 +90,11 @@ namespace benchmark
                 FirstNSPerCall = firstNSPerCall;
             }
         }
-        void UpdateAverage( double averageNSPerCall, bool firstTest )
+        void UpdateAverage( double averageNSPerCall, bool firstTest, double firstAverageNSPerCall )
         {
             AverageNSPerCall = averageNSPerCall;
             if (!firstTest)
-                AveragePercentFaster = (100.0 * (FirstNSPerCall - AverageNSPerCall)) / FirstNSPerCall;
+                AveragePercentFaster = (100.0 * (firstAverageNSPerCall - AverageNSPerCall)) / firstAverageNSPerCall;
         }
     };
 
@@ -106,8 +109,11 @@ namespace benchmark
         State            States;
         bool             WarnBadBenchmarkResults; // Auto detection
         bool             BrokenImplementation;    // Manually flagged by user
+        bool             Reference;               // Result is the expected result for the following benchmarks
+        int              Group;                   // Number of references before this one, %faster and rank are per group
+        std::string      DynamicName;             // Storage for Name when registered by BENCHMARK_DYNAMIC()
 
-        Benchmark(const BenchmarkFuncPtr InFunc, const char* InName, const bool InWorkingImplementation = true)
+        Benchmark(const BenchmarkFuncPtr InFunc, const char* InName, const bool InWorkingImplementation = true, const bool InReference = false)
         {
             Func = InFunc;
             Name = InName;
@@ -121,6 +127,8 @@ namespace benchmark
             WarnBadBenchmarkResults = false;
             MinPasses = 500;
             BrokenImplementation = !InWorkingImplementation;
+            Reference = InReference || RegisteredBenchmarks.empty();
+            Group     = RegisteredBenchmarks.empty() ? 0 : RegisteredBenchmarks.back()->Group + Reference;
         }
     };
 
@@ -183,8 +191,12 @@ namespace benchmark
             if (nRuns > 1)
                 printf( "--- Run %d of %d ---\n", iRun+1, nRuns );
 
+            Benchmark *reference = RegisteredBenchmarks[0];
             for (Benchmark* bench : RegisteredBenchmarks)
             {
+                if (bench->Reference)
+                    reference = bench;
+
                 const size_t len = strlen( bench->Name);
                 if (MaximumName < len)
                     MaximumName = len;
@@ -202,11 +214,11 @@ namespace benchmark
 
                 const double ooTotalCalls   = 1.0 / ((double)bench->Passes * (double)states.size());
                 const double ns             = (double) std::chrono::duration_cast<std::chrono::nanoseconds >(stop - start).count();
-                const bool   isFirstTest    = (bench != RegisteredBenchmarks[0]);
-                const double firstNSPerCall = RegisteredBenchmarks[0]->Metrics.NSPerCall;
+                const bool   isFirstTest    = (bench != reference);
+                const double firstNSPerCall = reference->Metrics.NSPerCall;
                 bench->Metrics.Update( ns, ooTotalCalls, isFirstTest, firstNSPerCall );
 
-                if (isFirstTest)
+                if (!bench->Reference)
                 {
                     if (ResultNoOptimize && (FirstNoOptimize != ResultNoOptimize))
                     {
@@ -242,7 +254,7 @@ namespace benchmark
                 RegisteredBenchmarks.clear();
                 for (Benchmark* bench : aRuns[ iRun ])
                 {
-                    Benchmark *copy = new Benchmark( bench->Func, bench->Name, !bench->BrokenImplementation );
+                    Benchmark *copy = new Benchmark( bench->Func, bench->Name, !bench->BrokenImplementation, bench->Reference );
                     copy->BrokenImplementation |= bench->WarnBadBenchmarkResults; // Auto-detect broken implementation
                     RegisteredBenchmarks.push_back( copy );
                 }
@@ -256,6 +268,8 @@ namespace benchmark
         {
             bool operator()(const Benchmark* a, const Benchmark* b) const
             {
+                if (a->Group != b->Group)
+                    return a->Group < b->Group;
                 return a->Metrics.ElapsedNS < b->Metrics.ElapsedNS;
             };
         } CompareElapsedNS;
@@ -279,11 +293,20 @@ namespace benchmark
                     , Separator );
         }
 
-        int iRank = 1;
+        int iRank  = 1;
+        int iGroup = -1;
         printf( "\n" );
         printf( "=== Summary (Best to Worst) ===\n" );
         for (Benchmark* bench : sorted)
         {
+            if (iGroup != bench->Group) // Each group is ranked on its own, against its reference
+            {
+                if (iGroup >= 0)
+                    printf( "\n" );
+                iGroup = bench->Group;
+                iRank  = 1;
+            }
+
             if (bench->BrokenImplementation)
                 printf( "%c -- ", Separator ); // Don't rank suspicious implementation to prevent gaming the system
             else
@@ -354,12 +377,15 @@ namespace benchmark
             }
 
             // Copy average into last benchmark results
+            int iReference = 0;
             for (int iTest = 0; iTest < nTests; iTest++)
             {
                 Benchmark *pBenchmarkN = RegisteredBenchmarks[ iTest ];
 
                 Benchmark *pLast = aRuns[ nRuns-1 ][ iTest ];
-                pLast->Metrics.UpdateAverage( averageCaller[ iTest ], !iTest );
+                if (pLast->Reference)
+                    iReference = iTest;
+                pLast->Metrics.UpdateAverage( averageCaller[ iTest ], iTest == iReference, averageCaller[ iReference ] );
 
                 // We need to copy the last run results into RegisteredBenchmarks
                 // since they were reset when the run ended in preparation for the next run.
@@ -394,6 +420,14 @@ namespace benchmark
         return benchmark;
     }
 
+    static Benchmark* RegisterDynamic(const std::string& name, const BenchmarkFuncPtr func)
+    {
+        Benchmark *benchmark = new Benchmark( func, "" );
+        benchmark->DynamicName = name;
+        benchmark->Name        = benchmark->DynamicName.c_str();
+        return Register( benchmark );
+    }
+
     static void DoNotOptimize(void*p)
     {
         ResultNoOptimize = p;
@@ -413,7 +447,10 @@ namespace benchmark
 #define BENCHMARK_2(FuncName,IsGood) static ::benchmark::Benchmark * MAKE_FUNC_NAME(FuncName) = ::benchmark::Register( new ::benchmark::Benchmark(FuncName, STRINGIFY(FuncName), IsGood ))
 #define BENCHMARK_1(FuncName)        BENCHMARK_2(FuncName,true)
 #define BENCHMARK(...)               CONCAT(BENCHMARK_,VARGS(__VA_ARGS__))(__VA_ARGS__)
+#define BENCHMARK_REFERENCE(FuncName) static ::benchmark::Benchmark * MAKE_FUNC_NAME(FuncName) = ::benchmark::Register( new ::benchmark::Benchmark(FuncName, STRINGIFY(FuncName), true, true ))
+#define BENCHMARK_DYNAMIC(Name,...)   ::benchmark::RegisterDynamic( Name, __VA_ARGS__ ) // Call at run time; Name is copied
 
 #else
     #include <benchmark/benchmark.h>
+    #define BENCHMARK_DYNAMIC(Name,...) ::benchmark::RegisterBenchmark( Name, __VA_ARGS__ ) // Copies the name too
 #endif
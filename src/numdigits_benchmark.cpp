@@ -3,9 +3,12 @@
 #include "util_benchmark.h"
 
 #include <assert.h>
+#include <charconv> // std::to_chars()
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <inttypes.h> // PRId64
+#include <math.h> // fabs()
 #include <limits>
 #include <random>
 #include <type_traits>
@@ -63,6 +66,205 @@ static void bench(benchmark::State& state) {
     }
 }
 
+// 64-bit IDs and timestamps: a random bit width then a random value of that width
+// so every magnitude 1 .. 20 digits shows up instead of almost always 19 or 20 digits.
+std::vector<std::uint64_t> prepare_samples_u64()
+{
+    std::mt19937_64 rg{ std::random_device{}() };
+
+    std::vector<std::uint64_t> samples(BENCHMARK_SAMPLE_SIZE);
+    for (auto& s : samples)
+        s = rg() >> std::uniform_int_distribution<int>{0, 63}(rg);
+
+    return samples;
+}
+
+static std::vector<std::uint64_t> samples_u64 = prepare_samples_u64();
+
+// Row ids, timestamps and offsets: the same magnitudes in ascending order
+std::vector<std::uint64_t> prepare_samples_u64_sorted()
+{
+    std::vector<std::uint64_t> samples = samples_u64;
+    std::sort( samples.begin(), samples.end() );
+    return samples;
+}
+
+static std::vector<std::uint64_t> samples_u64_sorted = prepare_samples_u64_sorted();
+
+// Same magnitudes with a random sign
+std::vector<std::int64_t> prepare_samples_i64()
+{
+    std::mt19937 rg{ std::random_device{}() };
+
+    std::vector<std::int64_t> samples(BENCHMARK_SAMPLE_SIZE);
+    for (size_t i = 0; i < samples.size(); i++)
+        samples[i] = (rg() & 1) ? -(std::int64_t)(samples_u64[i] >> 1) : (std::int64_t)(samples_u64[i] >> 1);
+
+    return samples;
+}
+
+static std::vector<std::int64_t> samples_i64 = prepare_samples_i64();
+
+// A digit length from a histogram then a random value of that length, e.g. mostly 1 .. 4 digits
+template <typename T, typename W, size_t N>
+std::vector<T> prepare_samples_lengths( const W (&aWeights)[ N ] )
+{
+    std::mt19937_64 rg{ std::random_device{}() };
+    std::discrete_distribution<int> length( aWeights, aWeights + N );
+
+    std::vector<T> samples(BENCHMARK_SAMPLE_SIZE);
+    for (auto& s : samples)
+    {
+        const int      digits = length(rg) + 1;
+        const uint64_t lo     = (digits == 1) ? 0 : Pow10_constexpr[ digits - 1 ];
+        const uint64_t hi     = (digits == N) ? (uint64_t)std::numeric_limits<T>::max() : Pow10_constexpr[ digits ] - 1;
+        s = (T) std::uniform_int_distribution<uint64_t>{lo, hi}(rg);
+    }
+
+    return samples;
+}
+
+// The same with a random sign; lengths count the digits of |n| and T is signed
+template <typename T, typename W, size_t N>
+std::vector<T> prepare_samples_lengths_signed( const W (&aWeights)[ N ] )
+{
+    std::mt19937 rg{ std::random_device{}() };
+
+    std::vector<T> samples = prepare_samples_lengths<T>( aWeights );
+    for (auto& s : samples)
+        if (rg() & 1)
+            s = -s;
+
+    return samples;
+}
+
+static std::vector<std::uint32_t> samples_small32 = prepare_samples_lengths<std::uint32_t>( Digits10_Weights_Small32 );
+static std::vector<std::uint64_t> samples_small64 = prepare_samples_lengths<std::uint64_t>( Digits10_Weights_Small64 );
+
+// Random finite bit patterns: every exponent equally likely and mostly the longest significands
+template <typename T, typename Bits>
+std::vector<T> prepare_samples_floating()
+{
+    std::mt19937_64 rg{ std::random_device{}() };
+
+    std::vector<T> samples(BENCHMARK_SAMPLE_SIZE);
+    for (auto& s : samples)
+        do
+        {
+            const Bits bits = (Bits) rg();
+            memcpy( &s, &bits, sizeof(s) );
+        } while (!std::isfinite( s ));
+
+    return samples;
+}
+
+static std::vector<double> samples_f64 = prepare_samples_floating<double, std::uint64_t>();
+static std::vector<float > samples_f32 = prepare_samples_floating<float , std::uint32_t>();
+
+// Prices like 12.34: the short lengths of the Small64 histogram scaled by 1/100
+std::vector<double> prepare_samples_cents()
+{
+    std::vector<double> samples(BENCHMARK_SAMPLE_SIZE);
+    for (size_t i = 0; i < samples.size(); i++)
+        samples[i] = (double) samples_small64[i] / 100;
+
+    return samples;
+}
+
+static std::vector<double> samples_cents = prepare_samples_cents();
+
+#if NUMDIGITS_INT128
+// 128-bit counters and decimal mantissas: a random bit width 1 .. 128 like samples_u64
+std::vector<unsigned __int128> prepare_samples_u128()
+{
+    std::mt19937_64 rg{ std::random_device{}() };
+
+    std::vector<unsigned __int128> samples(BENCHMARK_SAMPLE_SIZE);
+    for (auto& s : samples)
+    {
+        const unsigned __int128 x = ((unsigned __int128)rg() << 64) | rg();
+        s = x >> std::uniform_int_distribution<int>{0, 127}(rg);
+    }
+
+    return samples;
+}
+
+static std::vector<unsigned __int128> samples_u128 = prepare_samples_u128();
+
+// Same magnitudes with a random sign
+std::vector<__int128> prepare_samples_i128()
+{
+    std::mt19937 rg{ std::random_device{}() };
+
+    std::vector<__int128> samples(BENCHMARK_SAMPLE_SIZE);
+    for (size_t i = 0; i < samples.size(); i++)
+        samples[i] = (rg() & 1) ? -(__int128)(samples_u128[i] >> 1) : (__int128)(samples_u128[i] >> 1);
+
+    return samples;
+}
+
+static std::vector<__int128> samples_i128 = prepare_samples_i128();
+#endif
+
+template <typename T, typename R, R (*func)(T), const std::vector<T>& input>
+static void bench_64(benchmark::State& state) {
+    std::size_t idx = 0;
+
+    for (auto _ : state) {
+        auto result = func(input[idx]);
+        void *p = (void*)(uint64_t) result;
+        benchmark::DoNotOptimize(p);
+
+        if (++idx == input.size())
+            idx = 0;
+    }
+}
+
+static std::vector<std::uint8_t> lengths( BENCHMARK_SAMPLE_SIZE );
+
+// One call processes all the samples, which is the same number of calls as one pass of bench<func>,
+// so the reported ns/call is ns/element.
+template <void (*func)(const int32_t*, size_t, uint8_t*)>
+static void bench_batch(benchmark::State& state) {
+    (void) state;
+    func( (const int32_t*) samples.data(), samples.size(), lengths.data() );
+
+    // The last length is the same result as the last call of bench<func>
+    void *p = (void*)(uint64_t) lengths[ samples.size() - 1 ];
+    benchmark::DoNotOptimize(p);
+}
+
+template <typename T, void (*func)(const T*, size_t, uint8_t*), const std::vector<T>& input>
+static void bench_batch_64(benchmark::State& state) {
+    (void) state;
+    func( input.data(), input.size(), lengths.data() );
+
+    void *p = (void*)(uint64_t) lengths[ input.size() - 1 ];
+    benchmark::DoNotOptimize(p);
+}
+
+// One call reduces all the samples so again ns/call is ns/element.
+// The total length is the result, so reductions form their own group.
+template <void (*func)(const int32_t*, size_t, NumDigitsStats&)>
+static void bench_reduce(benchmark::State& state) {
+    (void) state;
+    NumDigitsStats stats = {};
+    func( (const int32_t*) samples.data(), samples.size(), stats );
+
+    void *p = (void*)(uint64_t) stats.Total;
+    benchmark::DoNotOptimize(p);
+}
+
+template <typename T, void (*func)(const T*, size_t, NumDigitsStats&), const std::vector<T>& input>
+static void bench_reduce_64(benchmark::State& state) {
+    (void) state;
+    NumDigitsStats stats = {};
+    func( input.data(), input.size(), stats );
+
+    void *p = (void*)(uint64_t) stats.Total;
+    benchmark::DoNotOptimize(p);
+}
+
 // ------------------------------------------------------------
 
 static void bench_numdigits_alexandrescu_v1(benchmark::State& state) {
@@ -80,6 +282,11 @@ static void bench_numdigits_alexandrescu_pohoreski_v3(benchmark::State& state) {
 }
 BENCHMARK(bench_numdigits_alexandrescu_pohoreski_v3);
 
+static void bench_numdigits_adaptive(benchmark::State& state) {
+    bench<numdigits_adaptive>(state);
+}
+BENCHMARK(bench_numdigits_adaptive);
+
 static void bench_numdigits_alink_buggy_v1(benchmark::State& state) {
     bench<numdigits_alink_buggy_v1>(state);
 }
@@ -120,6 +327,11 @@ static void bench_numdigits_clifford_fixed(benchmark::State& state) {
 }
 BENCHMARK(bench_numdigits_clifford_fixed);
 
+static void bench_numdigits_count(benchmark::State& state) {
+    bench<numdigits_count>(state);
+}
+BENCHMARK(bench_numdigits_count);
+
 static void bench_numdigits_dagostino_pohoreski(benchmark::State& state) {
     bench<numdigits_dagostino_pohoreski>(state);
 }
@@ -130,6 +342,11 @@ static void bench_numdigits_dumb_sprintf_strlen(benchmark::State& state) {
 }
 BENCHMARK(bench_numdigits_dumb_sprintf_strlen);
 
+static void bench_numdigits_fpexp(benchmark::State& state) {
+    bench<numdigits_fpexp>(state);
+}
+BENCHMARK(bench_numdigits_fpexp);
+
 static void bench_numdigits_gabriel_v1a(benchmark::State& state) {
     bench<numdigits_gabriel_v1a>(state);
 }
@@ -155,6 +372,16 @@ static void bench_numdigits_log(benchmark::State& state) {
 }
 BENCHMARK(bench_numdigits_log);
 
+static void bench_numdigits_lut32(benchmark::State& state) {
+    bench<numdigits_lut32>(state);
+}
+BENCHMARK(bench_numdigits_lut32);
+
+static void bench_numdigits_lzcnt(benchmark::State& state) {
+    bench<numdigits_lzcnt>(state);
+}
+BENCHMARK(bench_numdigits_lzcnt);
+
 static void bench_numdigits_microsoft_itoa_strlen(benchmark::State& state) {
     bench<numdigits_microsoft_itoa_strlen>(state);
 }
@@ -190,10 +417,12 @@ static void bench_numdigits_pohoreski_v3b(benchmark::State& state) {
 }
 BENCHMARK(bench_numdigits_pohoreski_v3b);
 
+// -INT_MIN is undefined so whether INT_MIN is right depends on how it is inlined;
+// the out of line copy can pass check_int() and still be wrong where numdigits_best_int() inlines it.
 static void bench_numdigits_pohoreski_v4a(benchmark::State& state) {
     bench<numdigits_pohoreski_v4a>(state);
 }
-BENCHMARK(bench_numdigits_pohoreski_v4a);
+BENCHMARK_2(bench_numdigits_pohoreski_v4a, false);
 
 static void bench_numdigits_pohoreski_v4b(benchmark::State& state) {
     bench<numdigits_pohoreski_v4b>(state);
@@ -225,11 +454,31 @@ static void bench_numdigits_simple_reverse(benchmark::State& state) {
 }
 BENCHMARK(bench_numdigits_simple_reverse);
 
+static void bench_numdigits_simple_reverse32(benchmark::State& state) {
+    bench<numdigits_simple_reverse32>(state);
+}
+BENCHMARK(bench_numdigits_simple_reverse32);
+
+static void bench_numdigits_template(benchmark::State& state) {
+    bench<numdigits<int>>(state);
+}
+BENCHMARK(bench_numdigits_template);
+
 static void bench_numdigits_thomas(benchmark::State& state) {
     bench<numdigits_thomas>(state);
 }
 BENCHMARK(bench_numdigits_thomas);
 
+static void bench_numdigits_tree_small32(benchmark::State& state) {
+    bench<numdigits_tree_small32>(state);
+}
+BENCHMARK(bench_numdigits_tree_small32);
+
+static void bench_numdigits_tree_uniform32(benchmark::State& state) {
+    bench<numdigits_tree_uniform32>(state);
+}
+BENCHMARK(bench_numdigits_tree_uniform32);
+
 static void bench_numdigits_user42690_buggy(benchmark::State& state) {
     bench<numdigits_user42690_buggy>(state);
 }
@@ -250,15 +499,1686 @@ static void bench_numdigits_vitali(benchmark::State& state) {
 }
 BENCHMARK(bench_numdigits_vitali);
 
-// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
-int main(int argc, char** argv)
+// Every digits10_*() core with every sign fold, registered as bench_fold_<core>_<fold>
+template <auto digits10, typename... SignFolds>
+static void register_fold_benchmarks( const char *pCore, SignFoldList<SignFolds...> )
 {
-    printf( "Benchmarking numdigits()\n" );
-    printf( "    sizeof( int     ) = %zu bytes\n", sizeof( int     ) );
-    printf( "    sizeof( int32   ) = %zu bytes\n", sizeof( int32_t ) );
-    printf( "    sizeof(long long) = %zu bytes\n", sizeof(long long) );
-    printf( "    sizeof( int64_t ) = %zu bytes\n", sizeof( int64_t ) );
-    printf( "    sizeof(uint64_t ) = %zu bytes\n", sizeof(uint64_t ) );
+    ( BENCHMARK_DYNAMIC( std::string( "bench_fold_" ) + pCore + "_" + SignFolds::Name, bench<numdigits_fold<SignFolds, digits10>> ), ... );
+}
+
+static bool register_fold_products()
+{
+#define REGISTER_FOLD( core ) register_fold_benchmarks<digits10_##core>( #core, NumDigitsSignFolds() );
+    NUMDIGITS_FOLD_CORES( REGISTER_FOLD )
+#undef REGISTER_FOLD
+    return true;
+}
+static bool fold_products_registered = register_fold_products();
+
+// ------------------------------------------------------------
+
+static void bench_numdigits_batch_scalar(benchmark::State& state) {
+    bench_batch<numdigits_batch_scalar>(state);
+}
+BENCHMARK(bench_numdigits_batch_scalar);
+
+static void bench_numdigits_count_batch(benchmark::State& state) {
+    bench_batch<numdigits_count_batch>(state);
+}
+BENCHMARK(bench_numdigits_count_batch);
+
+static void bench_numdigits_batch_swar(benchmark::State& state) {
+    bench_batch<numdigits_batch_swar>(state);
+}
+BENCHMARK(bench_numdigits_batch_swar);
+
+#if NUMDIGITS_X86
+static void bench_numdigits_batch_sse41(benchmark::State& state) {
+    if (cpu_features() & NUMDIGITS_CPU_SSE41)
+        bench_batch<numdigits_batch_sse41>(state);
+    else
+        bench_batch<numdigits_batch_scalar>(state);
+}
+BENCHMARK(bench_numdigits_batch_sse41);
+
+static void bench_numdigits_batch_avx2(benchmark::State& state) {
+    if (cpu_has_avx2())
+        bench_batch<numdigits_batch_avx2>(state);
+    else
+        bench_batch<numdigits_batch_scalar>(state);
+}
+BENCHMARK(bench_numdigits_batch_avx2);
+
+static void bench_numdigits_batch_fpexp_avx2(benchmark::State& state) {
+    if (cpu_has_avx2())
+        bench_batch<numdigits_batch_fpexp_avx2>(state);
+    else
+        bench_batch<numdigits_batch_scalar>(state);
+}
+BENCHMARK(bench_numdigits_batch_fpexp_avx2);
+
+static void bench_numdigits_batch_avx512(benchmark::State& state) {
+    if (cpu_features() & NUMDIGITS_CPU_AVX512)
+        bench_batch<numdigits_batch_avx512>(state);
+    else
+        bench_batch<numdigits_batch_scalar>(state);
+}
+BENCHMARK(bench_numdigits_batch_avx512);
+#endif
+
+// ------------------------------------------------------------
+// 64-bit columns have different samples so each group starts with its own reference
+
+static void bench_digits10_u64_numdigits10_uint64(benchmark::State& state) {
+    bench_64<uint64_t, uint32_t, numdigits10_uint64, samples_u64>(state);
+}
+BENCHMARK_REFERENCE(bench_digits10_u64_numdigits10_uint64);
+
+static void bench_digits10_u64_alexandrescu_v3(benchmark::State& state) {
+    bench_64<uint64_t, uint32_t, digits10_alexandrescu_v3, samples_u64>(state);
+}
+BENCHMARK(bench_digits10_u64_alexandrescu_v3);
+
+static void bench_digits10_u64_constexpr(benchmark::State& state) {
+    bench_64<uint64_t, uint32_t, digits10_constexpr, samples_u64>(state);
+}
+BENCHMARK(bench_digits10_u64_constexpr);
+
+static void bench_digits10_u64_dagostino(benchmark::State& state) {
+    bench_64<uint64_t, uint32_t, digits10_dagostino, samples_u64>(state);
+}
+BENCHMARK(bench_digits10_u64_dagostino);
+
+static void bench_digits10_u64_lzcnt(benchmark::State& state) {
+    bench_64<uint64_t, uint32_t, digits10_lzcnt, samples_u64>(state);
+}
+BENCHMARK(bench_digits10_u64_lzcnt);
+
+static void bench_digits10_u64_fpexp(benchmark::State& state) {
+    bench_64<uint64_t, uint32_t, digits10_fpexp, samples_u64>(state);
+}
+BENCHMARK(bench_digits10_u64_fpexp);
+
+static void bench_digits10_batch_u64_scalar(benchmark::State& state) {
+    bench_batch_64<uint64_t, digits10_batch_u64_scalar, samples_u64>(state);
+}
+BENCHMARK(bench_digits10_batch_u64_scalar);
+
+#if NUMDIGITS_X86
+static void bench_digits10_batch_u64_avx2(benchmark::State& state) {
+    if (cpu_has_avx2())
+        bench_batch_64<uint64_t, digits10_batch_u64_avx2, samples_u64>(state);
+    else
+        bench_batch_64<uint64_t, digits10_batch_u64_scalar, samples_u64>(state);
+}
+BENCHMARK(bench_digits10_batch_u64_avx2);
+#endif
+
+// ------------------------------------------------------------
+// Mostly 1 .. 4 digits: the tree generated for that histogram against the trees balanced for uniform input
+
+static void bench_digits10_small32_pohoreski_v3(benchmark::State& state) {
+    bench_64<uint32_t, uint32_t, digits10_pohoreski_v3, samples_small32>(state);
+}
+BENCHMARK_REFERENCE(bench_digits10_small32_pohoreski_v3);
+
+static void bench_digits10_small32_lzcnt_u32(benchmark::State& state) {
+    bench_64<uint32_t, uint32_t, digits10_lzcnt_u32, samples_small32>(state);
+}
+BENCHMARK(bench_digits10_small32_lzcnt_u32);
+
+static void bench_digits10_small32_fpexp_u32(benchmark::State& state) {
+    bench_64<uint32_t, uint32_t, digits10_fpexp_u32, samples_small32>(state);
+}
+BENCHMARK(bench_digits10_small32_fpexp_u32);
+
+static void bench_digits10_small32_lut32(benchmark::State& state) {
+    bench_64<uint32_t, uint32_t, digits10_lut32, samples_small32>(state);
+}
+BENCHMARK(bench_digits10_small32_lut32);
+
+static void bench_digits10_small32_tree_uniform32(benchmark::State& state) {
+    bench_64<uint32_t, uint32_t, digits10_tree_uniform32, samples_small32>(state);
+}
+BENCHMARK(bench_digits10_small32_tree_uniform32);
+
+static void bench_digits10_small32_tree_small32(benchmark::State& state) {
+    bench_64<uint32_t, uint32_t, digits10_tree_small32, samples_small32>(state);
+}
+BENCHMARK(bench_digits10_small32_tree_small32);
+
+static void bench_digits10_small64_pohoreski_v1(benchmark::State& state) {
+    bench_64<uint64_t, uint32_t, digits10_pohoreski_v1, samples_small64>(state);
+}
+BENCHMARK_REFERENCE(bench_digits10_small64_pohoreski_v1);
+
+static void bench_digits10_small64_alexandrescu_v3(benchmark::State& state) {
+    bench_64<uint64_t, uint32_t, digits10_alexandrescu_v3, samples_small64>(state);
+}
+BENCHMARK(bench_digits10_small64_alexandrescu_v3);
+
+static void bench_digits10_small64_lzcnt(benchmark::State& state) {
+    bench_64<uint64_t, uint32_t, digits10_lzcnt, samples_small64>(state);
+}
+BENCHMARK(bench_digits10_small64_lzcnt);
+
+static void bench_digits10_small64_fpexp(benchmark::State& state) {
+    bench_64<uint64_t, uint32_t, digits10_fpexp, samples_small64>(state);
+}
+BENCHMARK(bench_digits10_small64_fpexp);
+
+static void bench_digits10_small64_tree_small64(benchmark::State& state) {
+    bench_64<uint64_t, uint32_t, digits10_tree_small64, samples_small64>(state);
+}
+BENCHMARK(bench_digits10_small64_tree_small64);
+
+static void bench_numdigits_i64_simple_int64(benchmark::State& state) {
+    bench_64<int64_t, int, numdigits_simple_int64, samples_i64>(state);
+}
+BENCHMARK_REFERENCE(bench_numdigits_i64_simple_int64);
+
+static void bench_numdigits_i64_lzcnt_int64(benchmark::State& state) {
+    bench_64<int64_t, int32_t, numdigits_lzcnt_int64, samples_i64>(state);
+}
+BENCHMARK(bench_numdigits_i64_lzcnt_int64);
+
+static void bench_numdigits_i64_fpexp_int64(benchmark::State& state) {
+    bench_64<int64_t, int32_t, numdigits_fpexp_int64, samples_i64>(state);
+}
+BENCHMARK(bench_numdigits_i64_fpexp_int64);
+
+static void bench_numdigits_i64_template_int64(benchmark::State& state) {
+    bench_64<int64_t, int, numdigits<int64_t>, samples_i64>(state);
+}
+BENCHMARK(bench_numdigits_i64_template_int64);
+
+static void bench_numdigits_batch_i64_scalar(benchmark::State& state) {
+    bench_batch_64<int64_t, numdigits_batch_i64_scalar, samples_i64>(state);
+}
+BENCHMARK(bench_numdigits_batch_i64_scalar);
+
+#if NUMDIGITS_X86
+static void bench_numdigits_batch_i64_avx2(benchmark::State& state) {
+    if (cpu_has_avx2())
+        bench_batch_64<int64_t, numdigits_batch_i64_avx2, samples_i64>(state);
+    else
+        bench_batch_64<int64_t, numdigits_batch_i64_scalar, samples_i64>(state);
+}
+BENCHMARK(bench_numdigits_batch_i64_avx2);
+#endif
+
+#if NUMDIGITS_INT128
+static void bench_digits10_u128_numdigits10_uint128(benchmark::State& state) {
+    bench_64<unsigned __int128, uint32_t, numdigits10_uint128, samples_u128>(state);
+}
+BENCHMARK_REFERENCE(bench_digits10_u128_numdigits10_uint128);
+
+static void bench_digits10_u128(benchmark::State& state) {
+    bench_64<unsigned __int128, uint32_t, digits10_u128, samples_u128>(state);
+}
+BENCHMARK(bench_digits10_u128);
+
+static void bench_numdigits_i128_numdigits10_int128(benchmark::State& state) {
+    bench_64<__int128, int32_t, numdigits10_int128, samples_i128>(state);
+}
+BENCHMARK_REFERENCE(bench_numdigits_i128_numdigits10_int128);
+
+static void bench_numdigits_i128(benchmark::State& state) {
+    bench_64<__int128, int32_t, numdigits_i128, samples_i128>(state);
+}
+BENCHMARK(bench_numdigits_i128);
+#endif
+
+// ------------------------------------------------------------
+// Reductions: total length, max length and histogram, against calling the best scalar kernel in a loop
+
+template <typename T, int (*func)(T)>
+void reduce_call_per_number( const T *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+{
+    uint64_t aHistogram[ 21 ] = {};
+    for (size_t i = 0; i < nNumbers; i++)
+        aHistogram[ func( aNumbers[ i ] ) ]++;
+    numdigits_stats_add( stats, aHistogram, 20 );
+}
+
+static void bench_reduce_loop_alexandrescu_pohoreski_v3(benchmark::State& state) {
+    bench_reduce<reduce_call_per_number<int, numdigits_alexandrescu_pohoreski_v3>>(state);
+}
+BENCHMARK_REFERENCE(bench_reduce_loop_alexandrescu_pohoreski_v3);
+
+static void bench_numdigits_reduce_scalar(benchmark::State& state) {
+    bench_reduce<numdigits_reduce_scalar>(state);
+}
+BENCHMARK(bench_numdigits_reduce_scalar);
+
+static void bench_numdigits_count_reduce(benchmark::State& state) {
+    bench_reduce<numdigits_count_reduce>(state);
+}
+BENCHMARK(bench_numdigits_count_reduce);
+
+#if NUMDIGITS_X86
+static void bench_numdigits_reduce_avx2(benchmark::State& state) {
+    if (cpu_has_avx2())
+        bench_reduce<numdigits_reduce_avx2>(state);
+    else
+        bench_reduce<numdigits_reduce_scalar>(state);
+}
+BENCHMARK(bench_numdigits_reduce_avx2);
+#endif
+
+static void bench_reduce_i64_loop_template_int64(benchmark::State& state) {
+    bench_reduce_64<int64_t, reduce_call_per_number<int64_t, numdigits<int64_t>>, samples_i64>(state);
+}
+BENCHMARK_REFERENCE(bench_reduce_i64_loop_template_int64);
+
+static void bench_numdigits_reduce_i64_scalar(benchmark::State& state) {
+    bench_reduce_64<int64_t, numdigits_reduce_i64_scalar, samples_i64>(state);
+}
+BENCHMARK(bench_numdigits_reduce_i64_scalar);
+
+static void bench_numdigits_count_reduce_i64(benchmark::State& state) {
+    bench_reduce_64<int64_t, numdigits_count_reduce_i64, samples_i64>(state);
+}
+BENCHMARK(bench_numdigits_count_reduce_i64);
+
+#if NUMDIGITS_X86
+static void bench_numdigits_reduce_i64_avx2(benchmark::State& state) {
+    if (cpu_has_avx2())
+        bench_reduce_64<int64_t, numdigits_reduce_i64_avx2, samples_i64>(state);
+    else
+        bench_reduce_64<int64_t, numdigits_reduce_i64_scalar, samples_i64>(state);
+}
+BENCHMARK(bench_numdigits_reduce_i64_avx2);
+#endif
+
+// ------------------------------------------------------------
+// Sorted columns: a binary search per length change against calling numdigits10_uint64() per number
+
+void batch_u64_call_per_number( const uint64_t *aNumbers, size_t nNumbers, uint8_t *aLengths )
+{
+    for (size_t i = 0; i < nNumbers; i++)
+        aLengths[ i ] = (uint8_t) numdigits10_uint64( aNumbers[ i ] );
+}
+
+void reduce_u64_call_per_number( const uint64_t *aNumbers, size_t nNumbers, NumDigitsStats& stats )
+{
+    uint64_t aHistogram[ 21 ] = {};
+    for (size_t i = 0; i < nNumbers; i++)
+        aHistogram[ numdigits10_uint64( aNumbers[ i ] ) ]++;
+    numdigits_stats_add( stats, aHistogram, 20 );
+}
+
+static void bench_sorted_batch_loop_numdigits10_uint64(benchmark::State& state) {
+    bench_batch_64<uint64_t, batch_u64_call_per_number, samples_u64_sorted>(state);
+}
+BENCHMARK_REFERENCE(bench_sorted_batch_loop_numdigits10_uint64);
+
+static void bench_sorted_digits10_batch_u64_scalar(benchmark::State& state) {
+    bench_batch_64<uint64_t, digits10_batch_u64_scalar, samples_u64_sorted>(state);
+}
+BENCHMARK(bench_sorted_digits10_batch_u64_scalar);
+
+static void bench_sorted_digits10_batch_u64_sorted(benchmark::State& state) {
+    bench_batch_64<uint64_t, digits10_batch_u64_sorted, samples_u64_sorted>(state);
+}
+BENCHMARK(bench_sorted_digits10_batch_u64_sorted);
+
+static void bench_sorted_digits10_batch_u64_if_sorted(benchmark::State& state) {
+    bench_batch_64<uint64_t, digits10_batch_u64_if_sorted, samples_u64_sorted>(state);
+}
+BENCHMARK(bench_sorted_digits10_batch_u64_if_sorted);
+
+static void bench_sorted_reduce_loop_numdigits10_uint64(benchmark::State& state) {
+    bench_reduce_64<uint64_t, reduce_u64_call_per_number, samples_u64_sorted>(state);
+}
+BENCHMARK_REFERENCE(bench_sorted_reduce_loop_numdigits10_uint64);
+
+static void bench_sorted_digits10_reduce_u64_scalar(benchmark::State& state) {
+    bench_reduce_64<uint64_t, digits10_reduce_u64_scalar, samples_u64_sorted>(state);
+}
+BENCHMARK(bench_sorted_digits10_reduce_u64_scalar);
+
+static void bench_sorted_digits10_reduce_u64_sorted(benchmark::State& state) {
+    bench_reduce_64<uint64_t, digits10_reduce_u64_sorted, samples_u64_sorted>(state);
+}
+BENCHMARK(bench_sorted_digits10_reduce_u64_sorted);
+
+static void bench_sorted_digits10_reduce_u64_if_sorted(benchmark::State& state) {
+    bench_reduce_64<uint64_t, digits10_reduce_u64_if_sorted, samples_u64_sorted>(state);
+}
+BENCHMARK(bench_sorted_digits10_reduce_u64_if_sorted);
+
+// ------------------------------------------------------------
+// Writers: every one returns the length it wrote so each group is still checked against its reference.
+// The text goes into a global buffer so the compiler can't drop the writes.
+
+static char write_buffer[ 32 ];
+
+int write_int_sprintf( int n ) {
+    return sprintf( write_buffer, "%d", n );
+}
+
+int32_t write_i64_sprintf( int64_t n ) {
+    return sprintf( write_buffer, "%" PRId64, n );
+}
+
+uint32_t write_u64_sprintf( uint64_t n ) {
+    return (uint32_t) sprintf( write_buffer, "%" PRIu64, n );
+}
+
+template <typename T, typename R>
+R write_to_string( T n ) {
+    const std::string s = std::to_string( n );
+    memcpy( write_buffer, s.data(), s.size() );
+    return (R) s.size();
+}
+
+template <typename T, typename R>
+R write_to_chars( T n ) {
+    return (R)(std::to_chars( write_buffer, write_buffer + sizeof(write_buffer), n ).ptr - write_buffer);
+}
+
+int write_int_numdigits( int n ) {
+    return numdigits_write( write_buffer, n );
+}
+
+int32_t write_i64_numdigits( int64_t n ) {
+    return numdigits_write_int64( write_buffer, n );
+}
+
+uint32_t write_u64_numdigits( uint64_t n ) {
+    return digits10_write( write_buffer, n );
+}
+
+static void bench_write_int_sprintf(benchmark::State& state) {
+    bench<write_int_sprintf>(state);
+}
+BENCHMARK_REFERENCE(bench_write_int_sprintf);
+
+static void bench_write_int_to_string(benchmark::State& state) {
+    bench<write_to_string<int, int>>(state);
+}
+BENCHMARK(bench_write_int_to_string);
+
+static void bench_write_int_to_chars(benchmark::State& state) {
+    bench<write_to_chars<int, int>>(state);
+}
+BENCHMARK(bench_write_int_to_chars);
+
+static void bench_write_int_numdigits(benchmark::State& state) {
+    bench<write_int_numdigits>(state);
+}
+BENCHMARK(bench_write_int_numdigits);
+
+static void bench_write_i64_sprintf(benchmark::State& state) {
+    bench_64<int64_t, int32_t, write_i64_sprintf, samples_i64>(state);
+}
+BENCHMARK_REFERENCE(bench_write_i64_sprintf);
+
+static void bench_write_i64_to_string(benchmark::State& state) {
+    bench_64<int64_t, int32_t, write_to_string<int64_t, int32_t>, samples_i64>(state);
+}
+BENCHMARK(bench_write_i64_to_string);
+
+static void bench_write_i64_to_chars(benchmark::State& state) {
+    bench_64<int64_t, int32_t, write_to_chars<int64_t, int32_t>, samples_i64>(state);
+}
+BENCHMARK(bench_write_i64_to_chars);
+
+static void bench_write_i64_numdigits(benchmark::State& state) {
+    bench_64<int64_t, int32_t, write_i64_numdigits, samples_i64>(state);
+}
+BENCHMARK(bench_write_i64_numdigits);
+
+static void bench_write_u64_sprintf(benchmark::State& state) {
+    bench_64<uint64_t, uint32_t, write_u64_sprintf, samples_u64>(state);
+}
+BENCHMARK_REFERENCE(bench_write_u64_sprintf);
+
+static void bench_write_u64_to_string(benchmark::State& state) {
+    bench_64<uint64_t, uint32_t, write_to_string<uint64_t, uint32_t>, samples_u64>(state);
+}
+BENCHMARK(bench_write_u64_to_string);
+
+static void bench_write_u64_to_chars(benchmark::State& state) {
+    bench_64<uint64_t, uint32_t, write_to_chars<uint64_t, uint32_t>, samples_u64>(state);
+}
+BENCHMARK(bench_write_u64_to_chars);
+
+static void bench_write_u64_numdigits(benchmark::State& state) {
+    bench_64<uint64_t, uint32_t, write_u64_numdigits, samples_u64>(state);
+}
+BENCHMARK(bench_write_u64_numdigits);
+
+// ------------------------------------------------------------
+// Grouped: presizing by formatting twice (sprintf, then copy with separators) vs the length alone vs the fused writer
+
+static char grouped_buffer[ 96 ];
+
+template <typename T>
+int grouped_sprintf( T n, const char *pSeparator ) {
+    const int    nPlain = (std::is_same<T, int>::value) ? sprintf( write_buffer, "%d", (int)n ) : sprintf( write_buffer, "%" PRId64, (int64_t)n );
+    const int    sign   = (write_buffer[0] == '-');
+    const int    digits = nPlain - sign;
+    const size_t nBytes = strlen( pSeparator );
+    char *pOut = grouped_buffer;
+    if (sign)
+        *pOut++ = '-';
+    for (int i = 0; i < digits; i++) {
+        if (i && ((digits - i) % 3 == 0)) {
+            memcpy( pOut, pSeparator, nBytes );
+            pOut += nBytes;
+        }
+        *pOut++ = write_buffer[ sign + i ];
+    }
+    return (int)(pOut - grouped_buffer);
+}
+
+int grouped_int_comma_sprintf( int n ) {
+    return grouped_sprintf( n, "," );
+}
+
+int grouped_int_comma_numdigits( int n ) {
+    return numdigits_grouped( n );
+}
+
+int grouped_int_comma_write( int n ) {
+    return numdigits_write_grouped( grouped_buffer, n );
+}
+
+int grouped_int_nnbsp_sprintf( int n ) {
+    return grouped_sprintf( n, "\xE2\x80\xAF" );
+}
+
+int grouped_int_nnbsp_numdigits( int n ) {
+    return numdigits_grouped( n, 3, 3 );
+}
+
+int grouped_int_nnbsp_write( int n ) {
+    return numdigits_write_grouped( grouped_buffer, n, 3, "\xE2\x80\xAF", 3 );
+}
+
+int32_t grouped_i64_comma_sprintf( int64_t n ) {
+    return grouped_sprintf( n, "," );
+}
+
+int32_t grouped_i64_comma_numdigits( int64_t n ) {
+    return numdigits_grouped_int64( n );
+}
+
+int32_t grouped_i64_comma_write( int64_t n ) {
+    return numdigits_write_grouped_int64( grouped_buffer, n );
+}
+
+static void bench_grouped_int_comma_sprintf(benchmark::State& state) {
+    bench<grouped_int_comma_sprintf>(state);
+}
+BENCHMARK_REFERENCE(bench_grouped_int_comma_sprintf);
+
+static void bench_grouped_int_comma_numdigits(benchmark::State& state) {
+    bench<grouped_int_comma_numdigits>(state);
+}
+BENCHMARK(bench_grouped_int_comma_numdigits);
+
+static void bench_grouped_int_comma_write(benchmark::State& state) {
+    bench<grouped_int_comma_write>(state);
+}
+BENCHMARK(bench_grouped_int_comma_write);
+
+static void bench_grouped_int_nnbsp_sprintf(benchmark::State& state) {
+    bench<grouped_int_nnbsp_sprintf>(state);
+}
+BENCHMARK_REFERENCE(bench_grouped_int_nnbsp_sprintf);
+
+static void bench_grouped_int_nnbsp_numdigits(benchmark::State& state) {
+    bench<grouped_int_nnbsp_numdigits>(state);
+}
+BENCHMARK(bench_grouped_int_nnbsp_numdigits);
+
+static void bench_grouped_int_nnbsp_write(benchmark::State& state) {
+    bench<grouped_int_nnbsp_write>(state);
+}
+BENCHMARK(bench_grouped_int_nnbsp_write);
+
+static void bench_grouped_i64_comma_sprintf(benchmark::State& state) {
+    bench_64<int64_t, int32_t, grouped_i64_comma_sprintf, samples_i64>(state);
+}
+BENCHMARK_REFERENCE(bench_grouped_i64_comma_sprintf);
+
+static void bench_grouped_i64_comma_numdigits(benchmark::State& state) {
+    bench_64<int64_t, int32_t, grouped_i64_comma_numdigits, samples_i64>(state);
+}
+BENCHMARK(bench_grouped_i64_comma_numdigits);
+
+static void bench_grouped_i64_comma_write(benchmark::State& state) {
+    bench_64<int64_t, int32_t, grouped_i64_comma_write, samples_i64>(state);
+}
+BENCHMARK(bench_grouped_i64_comma_write);
+
+// ------------------------------------------------------------
+// Fixed point: money in cents (scale 2) and nanos trimmed like 1.5 (scale 9) of the int64_t samples
+
+template <uint32_t Scale, bool Trim>
+int32_t fixed_point_sprintf( int64_t n ) {
+    const uint64_t x   = (n < 0) ? 0ull - (uint64_t)n : (uint64_t)n;
+    const uint64_t p   = Pow10_constexpr[ Scale ];
+    int            len = sprintf( write_buffer, "%s%" PRIu64 ".%0*" PRIu64, (n < 0) ? "-" : "", x / p, (int)Scale, x % p );
+    if (Trim) {
+        while (write_buffer[ len - 1 ] == '0')
+            len--;
+        if (write_buffer[ len - 1 ] == '.')
+            len--;
+    }
+    return len;
+}
+
+template <uint32_t Scale, bool Trim>
+int32_t fixed_point_numdigits( int64_t n ) {
+    return numdigits_fixed_point( n, Scale, Trim );
+}
+
+template <uint32_t Scale, bool Trim>
+int32_t fixed_point_write( int64_t n ) {
+    return numdigits_write_fixed_point( write_buffer, n, Scale, Trim );
+}
+
+static void bench_fixed_point_2_sprintf(benchmark::State& state) {
+    bench_64<int64_t, int32_t, fixed_point_sprintf<2, false>, samples_i64>(state);
+}
+BENCHMARK_REFERENCE(bench_fixed_point_2_sprintf);
+
+static void bench_fixed_point_2_numdigits(benchmark::State& state) {
+    bench_64<int64_t, int32_t, fixed_point_numdigits<2, false>, samples_i64>(state);
+}
+BENCHMARK(bench_fixed_point_2_numdigits);
+
+static void bench_fixed_point_2_write(benchmark::State& state) {
+    bench_64<int64_t, int32_t, fixed_point_write<2, false>, samples_i64>(state);
+}
+BENCHMARK(bench_fixed_point_2_write);
+
+static void bench_fixed_point_9_trim_sprintf(benchmark::State& state) {
+    bench_64<int64_t, int32_t, fixed_point_sprintf<9, true>, samples_i64>(state);
+}
+BENCHMARK_REFERENCE(bench_fixed_point_9_trim_sprintf);
+
+static void bench_fixed_point_9_trim_numdigits(benchmark::State& state) {
+    bench_64<int64_t, int32_t, fixed_point_numdigits<9, true>, samples_i64>(state);
+}
+BENCHMARK(bench_fixed_point_9_trim_numdigits);
+
+static void bench_fixed_point_9_trim_write(benchmark::State& state) {
+    bench_64<int64_t, int32_t, fixed_point_write<9, true>, samples_i64>(state);
+}
+BENCHMARK(bench_fixed_point_9_trim_write);
+
+// ------------------------------------------------------------
+// Floating point: shortest round-trip %g length against the printf() + strtod() loop and std::to_chars()
+
+template <typename T>
+int floating_sprintf( T v ) {
+    for (int precision = 1; ; precision++) {
+        const int len = sprintf( write_buffer, "%.*g", precision, (double)v );
+        const T   x   = (sizeof(T) == sizeof(float)) ? (T)strtof( write_buffer, nullptr ) : (T)strtod( write_buffer, nullptr );
+        if (x == v)
+            return len;
+    }
+}
+
+// Shortest digits d.ddde+XX from std::to_chars() then the %g layout of those digits
+template <typename T>
+int floating_to_chars( T v ) {
+    char        buffer[ 64 ];
+    char       *pEnd  = std::to_chars( buffer, buffer + sizeof(buffer) - 1, v, std::chars_format::scientific ).ptr;
+    const char *pE    = (const char*) memchr( buffer, 'e', pEnd - buffer );
+    *pEnd = 0; // for atoi()
+    const int   sign  = (buffer[0] == '-');
+    if (!pE)
+        return (int)(pEnd - buffer); // inf nan
+    const int   p     = (int)(pE - buffer) - sign - ((pE - buffer) - sign > 1);
+    const int   x     = atoi( pE + 1 );
+    if ((x < -4) || (x >= p))
+        return (int)(pEnd - buffer); // same layout as %g
+    if (x >= 0)
+        return sign + p + (p > x + 1);
+    return sign + 1 - x + p;
+}
+
+// -float: the printf() + strtod() reference tries every precision so it costs microseconds per number,
+// 500 passes of the samples would take hours. Each sample set is timed once on a fixed slice instead.
+
+template <typename T>
+static double time_floating( int (*func)( T ), const std::vector<T>& numbers, size_t nNumbers, int nReps, uint64_t& sum )
+{
+    sum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+        for (int iRep = 0; iRep < nReps; iRep++)
+            for (size_t i = 0; i < nNumbers; i++)
+                sum += func( numbers[ i ] );
+    auto stop  = std::chrono::high_resolution_clock::now();
+
+    const double ns = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+    return ns / ((double)nReps * (double)nNumbers);
+}
+
+template <typename T>
+static void floating_row( const char *pName, const std::vector<T>& numbers, int (*numdigits)( T ) )
+{
+    const size_t NUMBERS = 10000;
+    const int    REPS    = 100;
+
+    uint64_t slowSum, charsSum, fastSum;
+    const double slowNS  = time_floating( floating_sprintf <T>, numbers, NUMBERS, 1   , slowSum  );
+    const double charsNS = time_floating( floating_to_chars<T>, numbers, NUMBERS, REPS, charsSum );
+    const double fastNS  = time_floating( numdigits           , numbers, NUMBERS, REPS, fastSum  );
+    if ((charsSum / REPS != slowSum) || (fastSum / REPS != slowSum))
+        printf( "WARNING %s implementation buggy?\n", pName );
+
+    printf( "| %-12s | %15.1f | %12.1f | %12.1f | %11.0fx | %11.1fx |\n", pName, slowNS, charsNS, fastNS, slowNS / fastNS, charsNS / fastNS );
+}
+
+int floating_sweep()
+{
+    printf( "| %-12s | %15s | %12s | %12s | %12s | %12s |\n", "Samples", "snprintf ns", "to_chars ns", "numdigits ns", "vs snprintf", "vs to_chars" );
+    printf( "|:-------------|----------------:|-------------:|-------------:|-------------:|-------------:|\n" );
+    floating_row( "double"      , samples_f64  , numdigits_double );
+    floating_row( "double cents", samples_cents, numdigits_double );
+    floating_row( "float"       , samples_f32  , numdigits_float  );
+    return 0;
+}
+
+// ------------------------------------------------------------
+// Magnitude: floor_log10(), pow10_ceil() and rounding to 3 significant digits against log10() and pow()
+
+// 2^64 and up doesn't convert back to uint64_t
+uint64_t magnitude_to_u64( double x ) {
+    return (x >= 18446744073709551616.0) ? 0 : (uint64_t)x;
+}
+
+uint64_t magnitude_floor_log10_log10( uint64_t n ) {
+    return n ? (uint64_t) log10( (double)n ) : 0;
+}
+
+uint64_t magnitude_floor_log10( uint64_t n ) {
+    return floor_log10( n );
+}
+
+uint64_t magnitude_pow10_ceil_pow( uint64_t n ) {
+    return (n <= 1) ? 1 : magnitude_to_u64( pow( 10.0, ceil( log10( (double)n ) ) ) );
+}
+
+uint64_t magnitude_pow10_ceil( uint64_t n ) {
+    return pow10_ceil( n );
+}
+
+uint64_t magnitude_round_3_pow( uint64_t n ) {
+    if (n < 1000)
+        return n;
+    const double unit = pow( 10.0, floor( log10( (double)n ) ) - 2 );
+    return magnitude_to_u64( floor( (double)n / unit + 0.5 ) * unit );
+}
+
+uint64_t magnitude_round_3( uint64_t n ) {
+    return round_significant10( n, 3 );
+}
+
+static void bench_floor_log10_log10(benchmark::State& state) {
+    bench_64<uint64_t, uint64_t, magnitude_floor_log10_log10, samples_u64>(state);
+}
+BENCHMARK_REFERENCE(bench_floor_log10_log10);
+
+static void bench_floor_log10_numdigits(benchmark::State& state) {
+    bench_64<uint64_t, uint64_t, magnitude_floor_log10, samples_u64>(state);
+}
+BENCHMARK(bench_floor_log10_numdigits);
+
+static void bench_pow10_ceil_pow(benchmark::State& state) {
+    bench_64<uint64_t, uint64_t, magnitude_pow10_ceil_pow, samples_u64>(state);
+}
+BENCHMARK_REFERENCE(bench_pow10_ceil_pow);
+
+static void bench_pow10_ceil_numdigits(benchmark::State& state) {
+    bench_64<uint64_t, uint64_t, magnitude_pow10_ceil, samples_u64>(state);
+}
+BENCHMARK(bench_pow10_ceil_numdigits);
+
+static void bench_round_significant_pow(benchmark::State& state) {
+    bench_64<uint64_t, uint64_t, magnitude_round_3_pow, samples_u64>(state);
+}
+BENCHMARK_REFERENCE(bench_round_significant_pow);
+
+static void bench_round_significant_numdigits(benchmark::State& state) {
+    bench_64<uint64_t, uint64_t, magnitude_round_3, samples_u64>(state);
+}
+BENCHMARK(bench_round_significant_numdigits);
+
+// ------------------------------------------------------------
+// Radix: hex, octal and base-36 lengths, against printf() + strlen() and std::to_chars()
+
+int radix_hex_sprintf_strlen( uint64_t n ) {
+    char buffer[ 32 ];
+    sprintf( buffer, "%" PRIx64, n );
+    return (int) strlen( buffer );
+}
+
+int radix_oct_sprintf_strlen( uint64_t n ) {
+    char buffer[ 32 ];
+    sprintf( buffer, "%" PRIo64, n );
+    return (int) strlen( buffer );
+}
+
+int radix_36_divide( uint64_t n ) {
+    return (int) digits_radix_reference( n, 36 );
+}
+
+template <int Base>
+int radix_to_chars( uint64_t n ) {
+    char buffer[ 72 ];
+    return (int)(std::to_chars( buffer, buffer + sizeof(buffer), n, Base ).ptr - buffer);
+}
+
+static void bench_radix_hex_sprintf_strlen(benchmark::State& state) {
+    bench_64<uint64_t, int, radix_hex_sprintf_strlen, samples_u64>(state);
+}
+BENCHMARK_REFERENCE(bench_radix_hex_sprintf_strlen);
+
+static void bench_radix_hex_to_chars(benchmark::State& state) {
+    bench_64<uint64_t, int, radix_to_chars<16>, samples_u64>(state);
+}
+BENCHMARK(bench_radix_hex_to_chars);
+
+static void bench_radix_hex_numdigits(benchmark::State& state) {
+    bench_64<uint64_t, int, numdigits<16, uint64_t>, samples_u64>(state);
+}
+BENCHMARK(bench_radix_hex_numdigits);
+
+static void bench_radix_oct_sprintf_strlen(benchmark::State& state) {
+    bench_64<uint64_t, int, radix_oct_sprintf_strlen, samples_u64>(state);
+}
+BENCHMARK_REFERENCE(bench_radix_oct_sprintf_strlen);
+
+static void bench_radix_oct_to_chars(benchmark::State& state) {
+    bench_64<uint64_t, int, radix_to_chars<8>, samples_u64>(state);
+}
+BENCHMARK(bench_radix_oct_to_chars);
+
+static void bench_radix_oct_numdigits(benchmark::State& state) {
+    bench_64<uint64_t, int, numdigits<8, uint64_t>, samples_u64>(state);
+}
+BENCHMARK(bench_radix_oct_numdigits);
+
+static void bench_radix_36_divide(benchmark::State& state) {
+    bench_64<uint64_t, int, radix_36_divide, samples_u64>(state);
+}
+BENCHMARK_REFERENCE(bench_radix_36_divide);
+
+static void bench_radix_36_to_chars(benchmark::State& state) {
+    bench_64<uint64_t, int, radix_to_chars<36>, samples_u64>(state);
+}
+BENCHMARK(bench_radix_36_to_chars);
+
+static void bench_radix_36_numdigits(benchmark::State& state) {
+    bench_64<uint64_t, int, numdigits<36, uint64_t>, samples_u64>(state);
+}
+BENCHMARK(bench_radix_36_numdigits);
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Autotune: -autotune[=file]
+// Times the correct implementations in interleaved rounds until the fastest one is clear of the noise,
+// then writes a header that binds numdigits_best_int() / numdigits_best_u64() to the winners.
+// Build with -DNUMDIGITS_TUNED_HEADER='"file"' to use it.
+
+struct TuneDesc
+{
+    benchmark::BenchmarkFuncPtr pBench;                                // Only to look up BrokenImplementation
+    bool                      (*pCheck)( const void *pFunc );          // Correct for every sample?
+    double                    (*pTime )( const void *pFunc, int nPasses ); // ns/call
+    const void                 *pFunc;
+    const char                 *pSymbol;
+
+    std::vector<double>         aNSPerCall; // one per round
+    double                      Median;
+    double                      MAD;
+    bool                        Alive;
+};
+
+// Random samples almost never hit the edges, so the check also runs the verify tables:
+// min, 0, max, nines, powers of 2 and powers of 10, each with and without the sign.
+static std::vector<int> prepare_edges_int()
+{
+    std::vector<int> edges = { INT_MIN, INT_MAX, 0 };
+    for (int bits = 0; bits < 31; bits++)
+        for (int n : { (1 << bits) - 1, 1 << bits })
+            edges.insert( edges.end(), { n, -n } );
+    for (int digits = 1; digits < 10; digits++)
+        for (int n : { (int)Pow10_u64[ digits - 1 ] - 1, (int)Pow10_u64[ digits - 1 ] })
+            edges.insert( edges.end(), { n, -n } );
+    return edges;
+}
+
+static std::vector<uint64_t> prepare_edges_u64()
+{
+    std::vector<uint64_t> edges = { 0, UINT64_MAX };
+    for (int bits = 0; bits < 64; bits++)
+        edges.insert( edges.end(), { (1ull << bits) - 1, 1ull << bits } );
+    for (int digits = 1; digits < 20; digits++)
+        edges.insert( edges.end(), { Pow10_u64[ digits - 1 ] - 1, Pow10_u64[ digits - 1 ] } );
+    return edges;
+}
+
+static const std::vector<int>      edges_int = prepare_edges_int();
+static const std::vector<uint64_t> edges_u64 = prepare_edges_u64();
+
+static bool check_int( const void *pFunc )
+{
+    int (*func)(int) = (int (*)(int)) pFunc;
+    for (int n : edges_int)
+        if (func( n ) != numdigits10_int( n ))
+            return false;
+    for (uint32_t s : samples)
+        if (func( (int)s ) != numdigits10_int( (int)s ))
+            return false;
+    return true;
+}
+
+static bool check_u64( const void *pFunc )
+{
+    uint32_t (*func)(uint64_t) = (uint32_t (*)(uint64_t)) pFunc;
+    for (uint64_t n : edges_u64)
+        if (func( n ) != numdigits10_uint64( n ))
+            return false;
+    for (uint64_t s : samples_u64)
+        if (func( s ) != numdigits10_uint64( s ))
+            return false;
+    return true;
+}
+
+// Unlike bench<func> every result is used and the call can't be inlined,
+// otherwise the compiler hoists the cheap implementations out of the loop and they all tie at loop overhead.
+// The indirect call costs the same for every candidate so the ranking still holds.
+static volatile uint64_t g_TuneSink;
+
+template <typename T, typename R, typename S>
+static double time_func( const void *pFunc, int nPasses, const std::vector<S>& input )
+{
+    R (* volatile func)(T) = (R (*)(T)) pFunc;
+    uint64_t sum = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+        for (int iPass = 0; iPass < nPasses; iPass++)
+            for (S s : input)
+                sum += func( (T) s );
+    auto stop  = std::chrono::high_resolution_clock::now();
+    g_TuneSink = sum;
+
+    const double ns = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+    return ns / ((double)nPasses * (double)input.size());
+}
+
+static double time_int( const void *pFunc, int nPasses )
+{
+    return time_func<int, int>( pFunc, nPasses, samples );
+}
+
+static double time_u64( const void *pFunc, int nPasses )
+{
+    return time_func<uint64_t, uint32_t>( pFunc, nPasses, samples_u64 );
+}
+
+#define TUNE_INT(func)              { bench_##func, check_int, time_int, (const void*) func, #func, {}, 0.0, 0.0, true }
+#define TUNE_INT_2(bench_func,func) { bench_func  , check_int, time_int, (const void*) func, #func, {}, 0.0, 0.0, true }
+#define TUNE_U64(bench_func,func)   { bench_func  , check_u64, time_u64, (const void*) func, #func, {}, 0.0, 0.0, true }
+
+// Robust statistics: one slow round from a context switch shouldn't pick the winner
+static void tune_stats( TuneDesc& tune )
+{
+    std::vector<double> v = tune.aNSPerCall;
+    std::sort( v.begin(), v.end() );
+    tune.Median = v[ v.size() / 2 ];
+
+    for (double& x : v)
+        x = fabs( x - tune.Median );
+    std::sort( v.begin(), v.end() );
+    tune.MAD = 1.4826 * v[ v.size() / 2 ]; // scaled to be comparable to a standard deviation
+}
+
+// Returns the winner, or nullptr if there were no correct candidates
+static const TuneDesc* tune_group( const char *pGroup, TuneDesc *aTunes, int nTunes, int& nRounds, int& nTied )
+{
+    const int    MIN_ROUNDS = 5;
+    const int    MAX_ROUNDS = 21;
+    const double SIGMAS     = 3.0;
+    const double SAMPLE_NS  = 20'000'000.0; // ~20 ms per sample
+
+    std::vector<int> aPasses( nTunes, 1 );
+
+    printf( "=== Autotune %s ===\n", pGroup );
+    for (int iTune = 0; iTune < nTunes; iTune++)
+    {
+        TuneDesc& tune = aTunes[ iTune ];
+
+        bool bBroken = false;
+        for (benchmark::Benchmark* bench : benchmark::RegisteredBenchmarks)
+            if (bench->Func == tune.pBench)
+                bBroken = bench->BrokenImplementation;
+
+        if (bBroken || !tune.pCheck( tune.pFunc ))
+        {
+            printf( "    SKIP %s (broken)\n", tune.pSymbol );
+            tune.Alive = false;
+            continue;
+        }
+
+        // Warm up and pick the number of passes for one sample
+        const double nsPerPass = tune.pTime( tune.pFunc, 1 ) * (double)BENCHMARK_SAMPLE_SIZE;
+        aPasses[ iTune ] = std::max( 1, std::min( 100, (int)(SAMPLE_NS / std::max( nsPerPass, 1.0 )) ) );
+    }
+
+    for (nRounds = 1; nRounds <= MAX_ROUNDS; nRounds++)
+    {
+        // Rotate the starting candidate each round so slow drift (thermals, turbo) is spread across everyone
+        for (int i = 0; i < nTunes; i++)
+        {
+            const int iTune = (i + nRounds) % nTunes;
+            if (aTunes[ iTune ].Alive)
+                aTunes[ iTune ].aNSPerCall.push_back( aTunes[ iTune ].pTime( aTunes[ iTune ].pFunc, aPasses[ iTune ] ) );
+        }
+
+        if (nRounds < MIN_ROUNDS)
+            continue;
+
+        const TuneDesc *pBest = nullptr;
+        for (int iTune = 0; iTune < nTunes; iTune++)
+            if (aTunes[ iTune ].Alive)
+            {
+                tune_stats( aTunes[ iTune ] );
+                if (!pBest || (aTunes[ iTune ].Median < pBest->Median))
+                    pBest = &aTunes[ iTune ];
+            }
+        if (!pBest)
+            break;
+
+        // Drop everyone that is clearly slower than the current best
+        nTied = 0;
+        for (int iTune = 0; iTune < nTunes; iTune++)
+        {
+            TuneDesc& tune = aTunes[ iTune ];
+            if (!tune.Alive)
+                continue;
+            if ((tune.Median - SIGMAS*tune.MAD) > (pBest->Median + SIGMAS*pBest->MAD))
+                tune.Alive = false;
+            else
+                nTied++;
+        }
+
+        if (nTied == 1)
+            break;
+    }
+    nRounds = std::min( nRounds, MAX_ROUNDS );
+
+    const TuneDesc *pBest = nullptr;
+    for (int iTune = 0; iTune < nTunes; iTune++)
+        if (aTunes[ iTune ].Alive && (!pBest || (aTunes[ iTune ].Median < pBest->Median)))
+            pBest = &aTunes[ iTune ];
+
+    for (int iTune = 0; iTune < nTunes; iTune++)
+        if (!aTunes[ iTune ].aNSPerCall.empty())
+            printf( "  %c %-40s %7.3f ns/call +/- %6.3f\n"
+                , aTunes[ iTune ].Alive ? '*' : ' ', aTunes[ iTune ].pSymbol, aTunes[ iTune ].Median, aTunes[ iTune ].MAD );
+    if (pBest)
+        printf( "    Best: %s after %d rounds (%d within noise)\n\n", pBest->pSymbol, nRounds, nTied );
+    return pBest;
+}
+
+int autotune( const char *pFileName )
+{
+    TuneDesc aTunesInt[] = {
+          TUNE_INT( numdigits_alexandrescu_v1               )
+        , TUNE_INT( numdigits_alexandrescu_pohoreski_v2     )
+        , TUNE_INT( numdigits_alexandrescu_pohoreski_v3     )
+        , TUNE_INT( numdigits_alink_buggy_v1                )
+        , TUNE_INT( numdigits_alink_buggy_v2                )
+        , TUNE_INT( numdigits_alink_fixed_v1a               )
+        , TUNE_INT( numdigits_alink_fixed_v1b               )
+        , TUNE_INT( numdigits_alink_fixed_v2a               )
+        , TUNE_INT( numdigits_alink_fixed_v2b               )
+        , TUNE_INT( numdigits_clifford_buggy                )
+        , TUNE_INT( numdigits_clifford_fixed                )
+        , TUNE_INT( numdigits_dagostino_pohoreski           )
+        , TUNE_INT( numdigits_dumb_sprintf_strlen           )
+        , TUNE_INT( numdigits_gabriel_v1a                   )
+        , TUNE_INT( numdigits_gabriel_v1b                   )
+        , TUNE_INT( numdigits_gabriel_v1c                   )
+        , TUNE_INT( numdigits_if_naive                      )
+        , TUNE_INT( numdigits_count                         )
+        , TUNE_INT( numdigits_fpexp                         )
+        , TUNE_INT( numdigits_log                           )
+        , TUNE_INT( numdigits_lzcnt                         )
+        , TUNE_INT( numdigits_microsoft_itoa_strlen         )
+        , TUNE_INT( numdigits_pohoreski_v1a                 )
+        , TUNE_INT( numdigits_pohoreski_v1b                 )
+        , TUNE_INT( numdigits_pohoreski_v2a                 )
+        , TUNE_INT( numdigits_pohoreski_v2b                 )
+        , TUNE_INT( numdigits_pohoreski_v3a                 )
+        , TUNE_INT( numdigits_pohoreski_v3b                 )
+        , TUNE_INT( numdigits_pohoreski_v4a                 )
+        , TUNE_INT( numdigits_pohoreski_v4b                 )
+        , TUNE_INT( numdigits_ransom                        )
+        , TUNE_INT_2( bench_numdigits_reference_int      , numdigits10_int       )
+        , TUNE_INT_2( bench_numdigits_reference_mixed_int, numdigits10_mixed_int )
+        , TUNE_INT( numdigits_simple                        )
+        , TUNE_INT( numdigits_simple_reverse                )
+        , TUNE_INT( numdigits_simple_reverse32              )
+        , TUNE_INT_2( bench_numdigits_template, numdigits<int> )
+        , TUNE_INT( numdigits_thomas                        )
+        , TUNE_INT( numdigits_user42690_buggy               )
+        , TUNE_INT( numdigits_user42690_fixed_a             )
+        , TUNE_INT( numdigits_user42690_fixed_b             )
+        , TUNE_INT( numdigits_vitali                        )
+    };
+    const int nTunesInt = sizeof(aTunesInt) / sizeof(aTunesInt[0]);
+
+    TuneDesc aTunesU64[] = {
+          TUNE_U64( bench_digits10_u64_numdigits10_uint64, numdigits10_uint64       )
+        , TUNE_U64( bench_digits10_u64_alexandrescu_v3   , digits10_alexandrescu_v3 )
+        , TUNE_U64( bench_digits10_u64_constexpr         , digits10_constexpr       )
+        , TUNE_U64( bench_digits10_u64_dagostino         , digits10_dagostino       )
+        , TUNE_U64( bench_digits10_u64_lzcnt             , digits10_lzcnt           )
+        , TUNE_U64( bench_digits10_u64_fpexp             , digits10_fpexp           )
+    };
+    const int nTunesU64 = sizeof(aTunesU64) / sizeof(aTunesU64[0]);
+
+    int nRoundsInt = 0, nTiedInt = 0;
+    int nRoundsU64 = 0, nTiedU64 = 0;
+    const TuneDesc *pBestInt = tune_group( "int"     , aTunesInt, nTunesInt, nRoundsInt, nTiedInt );
+    const TuneDesc *pBestU64 = tune_group( "uint64_t", aTunesU64, nTunesU64, nRoundsU64, nTiedU64 );
+    if (!pBestInt || !pBestU64)
+    {
+        printf( "ERROR: No correct implementation to pick.\n" );
+        return 1;
+    }
+
+    FILE *pFile = fopen( pFileName, "w" );
+    if (!pFile)
+    {
+        printf( "ERROR: Couldn't write: %s\n", pFileName );
+        return 1;
+    }
+
+    fprintf( pFile, "// Generated by: numdigits_benchmark -autotune=%s\n", pFileName );
+    fprintf( pFile, "// Do not edit. Re-run the autotune on the target host instead.\n" );
+    fprintf( pFile, "//\n" );
+    fprintf( pFile, "// Host: numdigits_count() = %s\n", numdigits_count_variant_scalar() );
+    fprintf( pFile, "// Input int     : uniform -2^31 .. 2^31-1\n" );
+    fprintf( pFile, "// Input uint64_t: random bit width 1 .. 64, uniform value\n" );
+    fprintf( pFile, "//\n" );
+    fprintf( pFile, "// int     : %-28s %7.3f ns/call +/- %.3f, %2d rounds, %d within noise\n", pBestInt->pSymbol, pBestInt->Median, pBestInt->MAD, nRoundsInt, nTiedInt );
+    fprintf( pFile, "// uint64_t: %-28s %7.3f ns/call +/- %.3f, %2d rounds, %d within noise\n", pBestU64->pSymbol, pBestU64->Median, pBestU64->MAD, nRoundsU64, nTiedU64 );
+    fprintf( pFile, "#define NUMDIGITS_TUNED 1\n" );
+    fprintf( pFile, "inline int      numdigits_best_int( int      n ) { return %s( n ); }\n", pBestInt->pSymbol );
+    fprintf( pFile, "inline uint32_t numdigits_best_u64( uint64_t n ) { return %s( n ); }\n", pBestU64->pSymbol );
+    fclose( pFile );
+
+    printf( "Wrote: %s\n", pFileName );
+    return 0;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Big integers: -bigint
+// The per call harness can't run a quadratic reference a million times per pass so this sweeps
+// 128 .. 65536 bit numbers and times digits10_bigint() against converting with numdigits10_bigint().
+// The first call also builds the table of 10^(2^i) so it is reported separately.
+// The second table mixes every bit length up to the size; the first pass is cold, the rest reuse the same numbers.
+
+template <typename Func>
+static double time_bigint( Func func, const std::vector<uint64_t>& numbers, size_t nLimbs, int nReps, size_t& digits )
+{
+    const size_t nNumbers = numbers.size() / nLimbs;
+    digits = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+        for (int iRep = 0; iRep < nReps; iRep++)
+            for (size_t iNumber = 0; iNumber < nNumbers; iNumber++)
+                digits += func( numbers.data() + iNumber*nLimbs, nLimbs );
+    auto stop  = std::chrono::high_resolution_clock::now();
+
+    const double ns = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+    return ns / ((double)nReps * (double)nNumbers);
+}
+
+int bigint_sweep()
+{
+    const size_t NUMBERS = 64;
+    std::mt19937_64 rg{ std::random_device{}() };
+
+    printf( "| %6s | %6s | %14s | %14s | %14s | %9s |\n", "Bits", "Digits", "First call ns", "Cached ns", "Reference ns", "Speedup" );
+    printf( "|-------:|-------:|---------------:|---------------:|---------------:|----------:|\n" );
+    for (size_t bits = 128; bits <= 65536; bits *= 2)
+    {
+        // Full bit length so every number hits the same cached power of 10
+        const size_t nLimbs = bits / 64;
+        std::vector<uint64_t> numbers( nLimbs * NUMBERS );
+        for (uint64_t& limb : numbers)
+            limb = rg();
+        for (size_t iNumber = 0; iNumber < NUMBERS; iNumber++)
+            numbers[ iNumber*nLimbs + nLimbs - 1 ] |= 1ull << 63;
+
+        auto start = std::chrono::high_resolution_clock::now();
+            size_t firstDigits = digits10_bigint( numbers.data(), nLimbs );
+        auto stop  = std::chrono::high_resolution_clock::now();
+        const double firstNS = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+
+        size_t fastDigits, slowDigits;
+        const int    nSlowReps = std::max( 1, (int)(16384 / bits) );
+        const double fastNS = time_bigint( digits10_bigint   , numbers, nLimbs, 10000    , fastDigits );
+        const double slowNS = time_bigint( numdigits10_bigint, numbers, nLimbs, nSlowReps, slowDigits );
+        if (fastDigits / 10000 != slowDigits / nSlowReps)
+            printf( "WARNING implementation buggy?\n" );
+
+        printf( "| %6zu | %6zu | %14.1f | %14.1f | %14.1f | %8.0fx |\n", bits, firstDigits, firstNS, fastNS, slowNS, slowNS / fastNS );
+    }
+
+    printf( "\nMixed bit lengths 1 .. Bits\n" );
+    printf( "| %6s | %14s | %14s | %14s | %9s |\n", "Bits", "First pass ns", "Cached ns", "Reference ns", "Speedup" );
+    printf( "|-------:|---------------:|---------------:|---------------:|----------:|\n" );
+    for (size_t bits = 128; bits <= 65536; bits *= 2)
+    {
+        // Every number padded to the same limb count, the leading zero limbs give it its own bit length
+        const size_t nLimbs   = bits / 64;
+        const size_t nNumbers = 256;
+        std::vector<uint64_t> numbers( nLimbs * nNumbers, 0 );
+        for (size_t iNumber = 0; iNumber < nNumbers; iNumber++)
+        {
+            const size_t numberBits = 1 + rg() % bits;
+            uint64_t *pNumber = numbers.data() + iNumber*nLimbs;
+            for (size_t iLimb = 0; iLimb < (numberBits + 63) / 64; iLimb++)
+                pNumber[ iLimb ] = rg();
+            pNumber[ (numberBits - 1) / 64 ] >>= 63 - (numberBits - 1) % 64;
+            pNumber[ (numberBits - 1) / 64 ] |= 1ull << ((numberBits - 1) % 64);
+        }
+
+        size_t firstDigits, fastDigits, slowDigits;
+        const int    nSlowReps = 1;
+        const double firstNS = time_bigint( digits10_bigint   , numbers, nLimbs, 1        , firstDigits );
+        const double fastNS  = time_bigint( digits10_bigint   , numbers, nLimbs, 100      , fastDigits  );
+        const double slowNS  = time_bigint( numdigits10_bigint, numbers, nLimbs, nSlowReps, slowDigits  );
+        if ((firstDigits != slowDigits) || (fastDigits / 100 != slowDigits))
+            printf( "WARNING implementation buggy?\n" );
+
+        printf( "| %6zu | %14.1f | %14.1f | %14.1f | %8.0fx |\n", bits, firstNS, fastNS, slowNS, slowNS / fastNS );
+    }
+    return 0;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Column serializer: -serialize
+// Writes the whole samples vector as "%d," text and reports MB/s of output.
+// sprintf and to_chars append into a buffer presized for the worst case (11 chars + delimiter per number)
+// like a caller that doesn't know the lengths up front would have to.
+
+template <typename Func>
+static double time_serialize( Func func, int nReps, std::vector<char>& text )
+{
+    auto start = std::chrono::high_resolution_clock::now();
+        for (int iRep = 0; iRep < nReps; iRep++)
+            func( text );
+    auto stop  = std::chrono::high_resolution_clock::now();
+
+    return (double) std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() / nReps;
+}
+
+static std::vector<size_t> offsets( BENCHMARK_SAMPLE_SIZE );
+
+int serialize_throughput()
+{
+    const int    REPS     = 20;
+    const size_t nNumbers = samples.size();
+
+    std::vector<char> expect;
+
+    struct SerializeDesc
+    {
+        const char *pName;
+        void      (*pFunc)( std::vector<char>& text );
+    };
+
+    const SerializeDesc aFuncs[] = {
+          { "sprintf", []( std::vector<char>& text ) {
+                text.resize( samples.size() * 12 + 1 ); // + NUL
+                char *p = text.data();
+                for (uint32_t n : samples)
+                    p += sprintf( p, "%d,", (int32_t)n );
+                text.resize( p - text.data() );
+            } }
+        , { "to_chars", []( std::vector<char>& text ) {
+                text.resize( samples.size() * 12 );
+                char *p = text.data(), *pEnd = p + text.size();
+                for (uint32_t n : samples) {
+                    p = std::to_chars( p, pEnd, (int32_t)n ).ptr;
+                    *p++ = ',';
+                }
+                text.resize( p - text.data() );
+            } }
+        , { "numdigits_serialize", []( std::vector<char>& text ) {
+                numdigits_serialize( (const int32_t*) samples.data(), samples.size(), ',', text );
+            } }
+        , { "  1. count_batch", []( std::vector<char>& ) {
+                numdigits_count_batch( (const int32_t*) samples.data(), samples.size(), lengths.data() );
+            } }
+        , { "  2. offsets", []( std::vector<char>& ) {
+                numdigits_serialize_offsets( lengths.data(), samples.size(), offsets.data() );
+            } }
+        , { "  3. write", []( std::vector<char>& text ) {
+                numdigits_serialize_write( (const int32_t*) samples.data(), samples.size(), lengths.data(), offsets.data(), text.data(), ',' );
+            } }
+    };
+
+    aFuncs[0].pFunc( expect );
+    const double MB = (double) expect.size() / (1024.0 * 1024.0);
+    printf( "%zu numbers, %.2f MB of text\n\n", nNumbers, MB );
+
+    printf( "| %-22s | %10s | %10s |\n", "Serializer", "ns/number", "MB/s" );
+    printf( "|:-----------------------|-----------:|-----------:|\n" );
+    std::vector<char> text( expect.size() );
+    for (const SerializeDesc& desc : aFuncs)
+    {
+        const double ns = time_serialize( desc.pFunc, REPS, text );
+        printf( "| %-22s | %10.3f | %10.1f |", desc.pName, ns / nNumbers, MB / (ns * 1e-9) );
+        if ((desc.pName[0] != ' ') && (text != expect))
+            printf( " WARNING implementation buggy?" );
+        printf( "\n" );
+    }
+    return 0;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Parallel: -parallel[=millions]
+// numdigits_parallel_stats() over an array much bigger than the caches (default 64M ints = 256 MB)
+// with 1, 2, 4 .. all hardware threads. GB/s is the input read bandwidth; once it stops scaling
+// the memory bus, not the kernel, is the limit.
+
+int parallel_scaling( size_t nMillions )
+{
+    const size_t   nNumbers = nMillions * 1000000;
+    const unsigned nCores   = std::max( 1u, std::thread::hardware_concurrency() );
+    const double   GB       = (double)(nNumbers * sizeof(int32_t)) / 1e9;
+
+    std::vector<int32_t> numbers( nNumbers );
+    std::mt19937 rg{ std::random_device{}() };
+    for (int32_t& n : numbers)
+        n = (int32_t) rg();
+
+    printf( "%zu numbers, %.2f GB, %u hardware threads\n\n", nNumbers, GB, nCores );
+
+    // Call per element is the baseline
+    auto start = std::chrono::high_resolution_clock::now();
+        uint64_t expect = 0;
+        for (int32_t n : numbers)
+            expect += numdigits_alexandrescu_pohoreski_v3( n );
+    auto stop  = std::chrono::high_resolution_clock::now();
+    const double baseNS = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+
+    printf( "| %-20s | %10s | %9s | %8s | %8s |\n", "Threads", "ms", "ns/number", "GB/s", "Speedup" );
+    printf( "|:---------------------|-----------:|----------:|---------:|---------:|\n" );
+    printf( "| %-20s | %10.1f | %9.3f | %8.2f | %7.2fx |\n", "1 (call per number)", baseNS / 1e6, baseNS / nNumbers, GB / (baseNS * 1e-9), 1.0 );
+
+    std::vector<unsigned> aThreads;
+    for (unsigned nThreads = 1; nThreads < nCores; nThreads *= 2)
+        aThreads.push_back( nThreads );
+    aThreads.push_back( nCores );
+
+    for (unsigned nThreads : aThreads)
+    {
+        // Best of 3 since thread start up is noisy
+        double ns = 1e300;
+        NumDigitsStats stats = {};
+        for (int iRep = 0; iRep < 3; iRep++)
+        {
+            start = std::chrono::high_resolution_clock::now();
+                stats = numdigits_parallel_stats( numbers.data(), nNumbers, nThreads );
+            stop  = std::chrono::high_resolution_clock::now();
+            ns = std::min( ns, (double) std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() );
+        }
+
+        printf( "| %-20u | %10.1f | %9.3f | %8.2f | %7.2fx |", nThreads, ns / 1e6, ns / nNumbers, GB / (ns * 1e-9), baseNS / ns );
+        if (stats.Total != expect)
+            printf( " WARNING implementation buggy?" );
+        printf( "\n" );
+    }
+    return 0;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// LUT footprint: -lut
+// ns/call of the LUT kernels next to their table size, against the comparison tree which has no table.
+// Warm: the same burst of calls again with the table already cached.
+// Cold: a buffer bigger than the last level cache is written before every burst, so the table comes from DRAM.
+// A burst is short enough that a cold table is mostly misses, like a call site that only runs now and then.
+
+static uint32_t lut_digits10_lut16( uint32_t n ) {
+    return digits10_lut16( (uint16_t) n );
+}
+
+static double time_burst( uint32_t (* volatile func)(uint32_t), const uint32_t *aInput, size_t nInput, uint64_t& sink )
+{
+    auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < nInput; i++)
+            sink += func( aInput[ i ] );
+    auto stop  = std::chrono::high_resolution_clock::now();
+    return (double) std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+}
+
+int lut_footprint()
+{
+    const size_t BURST  = 1000;
+    const int    ROUNDS = 50;
+
+    std::vector<uint8_t> evict( 64 * 1024 * 1024 );
+
+    std::vector<uint32_t> input16( BURST ), input32( BURST );
+    for (size_t i = 0; i < BURST; i++) {
+        input16[ i ] = samples[ i ] & 0xFFFF;
+        input32[ i ] = samples[ i ];
+    }
+
+    struct LutDesc
+    {
+        const char *pName;
+        uint32_t  (*pFunc)( uint32_t );
+        size_t      nBytes;
+        bool        b32; // 16-bit kernels only get 16-bit input
+    };
+
+    const LutDesc aFuncs[] = {
+          { "digits10_pohoreski_v3", digits10_pohoreski_v3, 0                                       , true  }
+        , { "digits10_lut16"       , lut_digits10_lut16   , sizeof(Digits10_LUT.Lo)                 , false }
+        , { "digits10_lut32"       , digits10_lut32       , sizeof(Digits10_LUT) + sizeof(Pow10_constexpr), true }
+    };
+
+    printf( "%zu calls per burst, best of %d, %zu MB eviction buffer\n\n", BURST, ROUNDS, evict.size() >> 20 );
+    printf( "| %-22s | %6s | %10s | %10s | %10s |\n", "Kernel", "Input", "Table", "Warm ns", "Cold ns" );
+    printf( "|:-----------------------|:-------|-----------:|-----------:|-----------:|\n" );
+
+    uint64_t sink = 0;
+    for (int b32 = 0; b32 < 2; b32++)
+    {
+        const uint32_t *aInput = b32 ? input32.data() : input16.data();
+        for (const LutDesc& desc : aFuncs)
+        {
+            if (b32 && !desc.b32)
+                continue;
+
+            uint64_t actual = 0, expect = 0;
+            for (size_t i = 0; i < BURST; i++) {
+                actual += desc.pFunc( aInput[ i ] );
+                expect += digits10_pohoreski_v3( aInput[ i ] );
+            }
+
+            double warm = 1e300, cold = 1e300;
+            for (int iRound = 0; iRound < ROUNDS; iRound++)
+            {
+                for (size_t i = 0; i < evict.size(); i += 64)
+                    evict[ i ] += (uint8_t) iRound;
+                cold = std::min( cold, time_burst( desc.pFunc, aInput, BURST, sink ) );
+                warm = std::min( warm, time_burst( desc.pFunc, aInput, BURST, sink ) );
+            }
+
+            printf( "| %-22s | %6s | %10zu | %10.3f | %10.3f |", desc.pName, b32 ? "32-bit" : "16-bit", desc.nBytes, warm / BURST, cold / BURST );
+            if (actual != expect)
+                printf( " WARNING implementation buggy?" );
+            printf( "\n" );
+        }
+    }
+    g_TuneSink = sink;
+    return 0;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Adaptive: -adaptive
+// A stream whose distribution shifts every phase, timed per phase for each fixed kernel and numdigits_adaptive().
+// The oracle is the best fixed kernel of every phase, i.e. switching for free at the right moment.
+// adaptive - oracle is what sampling and switching cost, best fixed - adaptive is what they win.
+// The calibration numdigits_adaptive() ran on its first retune decides whether each ladder can be chosen at all.
+// Every kernel is called through a pointer so the fixed ones pay for the same indirect call.
+
+static uint64_t sum_digits( int (*func)( int ), const int32_t *aNumbers, size_t nNumbers )
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < nNumbers; i++)
+        sum += func( aNumbers[ i ] );
+    return sum;
+}
+
+int adaptive_shift()
+{
+    const size_t PHASE  = 64 * NUMDIGITS_ADAPTIVE_PERIOD;
+    const int    ROUNDS = 10;
+
+    struct PhaseDesc
+    {
+        const char *pName;
+        uint32_t    nMin;
+        uint32_t    nMax;
+        bool        bBitWidth; // random bit width instead of uniform
+    };
+
+    const PhaseDesc aPhases[] = {
+          { "1 .. 4 digits" ,             0,      9'999, false }
+        , { "9 .. 10 digits", 1'000'000'000,  INT32_MAX, false }
+        , { "every width"   ,             0,  INT32_MAX, true  }
+        , { "1 .. 2 digits" ,             0,         99, false }
+        , { "10 digits"     , 1'000'000'000,  INT32_MAX, false }
+        , { "1 .. 4 digits" ,             0,      9'999, false }
+        , { "every width"   ,             0,  INT32_MAX, true  }
+    };
+    const size_t nPhases = sizeof(aPhases) / sizeof(aPhases[0]);
+
+    std::mt19937 rg{ std::random_device{}() };
+    std::vector<int32_t> numbers( nPhases * PHASE );
+    for (size_t iPhase = 0; iPhase < nPhases; iPhase++)
+    {
+        const PhaseDesc& phase = aPhases[ iPhase ];
+        for (size_t i = 0; i < PHASE; i++)
+        {
+            int32_t n = (int32_t) std::uniform_int_distribution<uint32_t>{phase.nMin, phase.nMax}(rg);
+            if (phase.bBitWidth)
+                n >>= std::uniform_int_distribution<int>{0, 30}(rg);
+            numbers[ iPhase * PHASE + i ] = (rg() & 1) ? -n : n;
+        }
+    }
+
+    struct KernelDesc
+    {
+        const char *pName;
+        int       (*pFunc)( int );
+    };
+
+    const KernelDesc aKernels[] = {
+          { NumDigits_Adaptive_Kernels[ NUMDIGITS_ADAPTIVE_SMALL      ].pName, NumDigits_Adaptive_Kernels[ NUMDIGITS_ADAPTIVE_SMALL      ].pFunc }
+        , { NumDigits_Adaptive_Kernels[ NUMDIGITS_ADAPTIVE_LARGE      ].pName, NumDigits_Adaptive_Kernels[ NUMDIGITS_ADAPTIVE_LARGE      ].pFunc }
+        , { NumDigits_Adaptive_Kernels[ NUMDIGITS_ADAPTIVE_BRANCHLESS ].pName, NumDigits_Adaptive_Kernels[ NUMDIGITS_ADAPTIVE_BRANCHLESS ].pFunc }
+        , { "adaptive"                                                       , numdigits_adaptive                                                }
+    };
+    const size_t nKernels = sizeof(aKernels) / sizeof(aKernels[0]);
+    const size_t ADAPTIVE = nKernels - 1;
+
+    // Best of ROUNDS per phase and kernel. The adaptive one runs the phases in order
+    // every round so it always starts a phase tuned for the previous one.
+    std::vector<double> aNS( nPhases * nKernels, 1e300 );
+    std::vector<const char*> aChosen( nPhases );
+    uint64_t expect = 0, sink = 0;
+    for (size_t i = 0; i < numbers.size(); i++)
+        expect += numdigits10_int( numbers[ i ] );
+
+    const uint32_t nSwitches = numdigits_adaptive_switches();
+    for (int iRound = 0; iRound < ROUNDS; iRound++)
+    {
+        for (size_t iKernel = 0; iKernel < nKernels; iKernel++)
+        {
+            uint64_t actual = 0;
+            for (size_t iPhase = 0; iPhase < nPhases; iPhase++)
+            {
+                auto start = std::chrono::high_resolution_clock::now();
+                    actual += sum_digits( aKernels[ iKernel ].pFunc, &numbers[ iPhase * PHASE ], PHASE );
+                auto stop  = std::chrono::high_resolution_clock::now();
+
+                double& ns = aNS[ iPhase * nKernels + iKernel ];
+                ns = std::min( ns, (double) std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() / PHASE );
+                if (iKernel == ADAPTIVE)
+                    aChosen[ iPhase ] = numdigits_adaptive_variant();
+            }
+            if (actual != expect)
+                printf( "WARNING %s implementation buggy?\n", aKernels[ iKernel ].pName );
+            sink += actual;
+        }
+    }
+    const uint32_t nSwitchesPerRound = (numdigits_adaptive_switches() - nSwitches) / ROUNDS;
+
+    printf( "%zu phases of %zu numbers, both signs, best of %d, retune every %d calls\n\n", nPhases, PHASE, ROUNDS, NUMDIGITS_ADAPTIVE_PERIOD );
+    printf( "| %-14s |", "Phase" );
+    for (const KernelDesc& kernel : aKernels)
+        printf( " %12s |", kernel.pName );
+    printf( " %12s | %-12s |\n", "oracle", "adaptive ends" );
+    printf( "|:---------------|" );
+    for (size_t iKernel = 0; iKernel <= nKernels; iKernel++)
+        printf( "-------------:|" );
+    printf( ":--------------|\n" );
+
+    std::vector<double> aTotal( nKernels, 0.0 );
+    double oracle = 0.0;
+    for (size_t iPhase = 0; iPhase < nPhases; iPhase++)
+    {
+        double best = 1e300;
+        printf( "| %-14s |", aPhases[ iPhase ].pName );
+        for (size_t iKernel = 0; iKernel < nKernels; iKernel++)
+        {
+            const double ns = aNS[ iPhase * nKernels + iKernel ];
+            printf( " %12.3f |", ns );
+            aTotal[ iKernel ] += ns / nPhases;
+            if (iKernel != ADAPTIVE)
+                best = std::min( best, ns );
+        }
+        oracle += best / nPhases;
+        printf( " %12.3f | %-13s |\n", best, aChosen[ iPhase ] );
+    }
+    printf( "| %-14s |", "average" );
+    for (size_t iKernel = 0; iKernel < nKernels; iKernel++)
+        printf( " %12.3f |", aTotal[ iKernel ] );
+    printf( " %12.3f | %-13s |\n\n", oracle, "" );
+
+    const double bestFixed = *std::min_element( aTotal.begin(), aTotal.begin() + ADAPTIVE );
+    const NumDigitsAdaptiveCalibration& calibration = numdigits_adaptive_calibration();
+    for (int iLadder = 0; iLadder < NUMDIGITS_ADAPTIVE_BRANCHLESS; iLadder++)
+        printf( "Calibrated %-16s: %.3f ns/number vs branchless %.3f, %s\n", NumDigits_Adaptive_Kernels[ iLadder ].pName,
+            calibration.LadderNS[ iLadder ], calibration.BranchlessNS[ iLadder ], calibration.LadderWins[ iLadder ] ? "used" : "never used" );
+    printf( "Switches per pass          : %u\n", nSwitchesPerRound );
+    printf( "Sampling + switching cost  : %+.3f ns/number (adaptive - oracle)\n", aTotal[ ADAPTIVE ] - oracle );
+    printf( "Win over best fixed kernel : %+.3f ns/number (best fixed - adaptive)\n", bestFixed - aTotal[ ADAPTIVE ] );
+
+    g_TuneSink = sink;
+    return 0;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Profile: -profile=file
+// Replaces the uniform samples with the digit lengths of an exit profile (see NUMDIGITS_PROFILE in numdigits.h)
+// then runs the usual benchmarks. The int samples use the 1 .. 10 digit lengths, the uint64_t samples 1 .. 20
+// and the int64_t samples 1 .. 19 with the 20 digit calls counted as 19. The signed samples get a random sign.
+// Every function in the profile counts, so profile one kernel per call site or the calls add up.
+
+static int load_profile( const char *pFileName )
+{
+    FILE *pFile = fopen( pFileName, "r" );
+    if (!pFile)
+    {
+        printf( "ERROR: Couldn't open profile: %s\n", pFileName );
+        return 1;
+    }
+
+    uint64_t aCalls[ 21 ] = {}; // 0 .. 20 digits
+    char     line[ 256 ];
+    while (fgets( line, sizeof( line ), pFile ))
+    {
+        char               func[ 128 ];
+        unsigned           digits;
+        unsigned long long calls;
+        if ((sscanf( line, "length %127s %u %llu", func, &digits, &calls ) == 3) && (digits < 21))
+            aCalls[ digits ] += calls;
+    }
+    fclose( pFile );
+
+    uint64_t aWeights32 [ 10 ] = {};
+    uint64_t aWeightsI64[ 19 ] = {};
+    uint64_t aWeights64 [ 20 ] = {};
+    uint64_t nCalls32 = 0, nCalls64 = 0;
+    for (int digits = 1; digits <= 20; digits++)
+    {
+        if (digits <= 10)
+            nCalls32 += aWeights32[ digits - 1 ] = aCalls[ digits ];
+        aWeightsI64[ std::min( digits, 19 ) - 1 ] += aCalls[ digits ]; // INT64_MAX has 19 digits
+        nCalls64 += aWeights64[ digits - 1 ] = aCalls[ digits ];
+    }
+
+    printf( "Profile: %s\n", pFileName );
+    printf( "| Digits |                Calls |       %% |\n" );
+    printf( "|-------:|---------------------:|--------:|\n" );
+    for (int digits = 1; digits <= 20; digits++)
+        if (aCalls[ digits ])
+            printf( "| %6d | %20llu | %6.2f%% |\n", digits, (unsigned long long) aCalls[ digits ], 100.0 * aCalls[ digits ] / nCalls64 );
+    printf( "\n" );
+
+    if (!nCalls64)
+    {
+        printf( "ERROR: No length lines in profile\n" );
+        return 1;
+    }
+
+    if (nCalls32)
+    {
+        const std::vector<std::int32_t> samples32 = prepare_samples_lengths_signed<std::int32_t>( aWeights32 );
+        samples.assign( samples32.begin(), samples32.end() ); // same bits if samples is unsigned
+    }
+    samples_u64 = prepare_samples_lengths       <std::uint64_t>( aWeights64  );
+    samples_u64_sorted = prepare_samples_u64_sorted();
+    samples_i64 = prepare_samples_lengths_signed<std::int64_t >( aWeightsI64 );
+    return 0;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+int main(int argc, char** argv)
+{
+    printf( "Benchmarking numdigits()\n" );
+    printf( "    sizeof( int     ) = %zu bytes\n", sizeof( int     ) );
+    printf( "    sizeof( int32   ) = %zu bytes\n", sizeof( int32_t ) );
+    printf( "    sizeof(long long) = %zu bytes\n", sizeof(long long) );
+    printf( "    sizeof( int64_t ) = %zu bytes\n", sizeof( int64_t ) );
+    printf( "    sizeof(uint64_t ) = %zu bytes\n", sizeof(uint64_t ) );
+    printf( "    numdigits_count   = %s (scalar / batch / reduce)\n", numdigits_count_variant() );
+
+    for (int iArg = 1; iArg < argc; iArg++)
+    {
+        if (strcmp( argv[ iArg ], "-autotune" ) == 0)
+            return autotune( "numdigits_tuned.h" );
+        if (strncmp( argv[ iArg ], "-autotune=", 10 ) == 0)
+            return autotune( argv[ iArg ] + 10 );
+        if (strcmp( argv[ iArg ], "-bigint" ) == 0)
+            return bigint_sweep();
+        if (strcmp( argv[ iArg ], "-float" ) == 0)
+            return floating_sweep();
+        if (strcmp( argv[ iArg ], "-serialize" ) == 0)
+            return serialize_throughput();
+        if (strcmp( argv[ iArg ], "-adaptive" ) == 0)
+            return adaptive_shift();
+        if (strcmp( argv[ iArg ], "-lut" ) == 0)
+            return lut_footprint();
+        if (strcmp( argv[ iArg ], "-parallel" ) == 0)
+            return parallel_scaling( 64 );
+        if (strncmp( argv[ iArg ], "-parallel=", 10 ) == 0)
+            return parallel_scaling( std::max( 1, atoi( argv[ iArg ] + 10 ) ) );
+        if (strncmp( argv[ iArg ], "-profile=", 9 ) == 0)
+            if (load_profile( argv[ iArg ] + 9 ))
+                return 1;
+    }
 
     benchmark::Initialize(&argc, argv);
     benchmark::RunSpecifiedBenchmarks();
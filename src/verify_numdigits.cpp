@@ -2,7 +2,11 @@
     #include <stdio.h>    // printf()
     #include <assert.h>
     #include <inttypes.h> // PRId64
+    #include <stdlib.h>   // abs( int64_t ) overload
+    #include <string.h>   // strlen() strcmp()
     #include <algorithm>  // abs()
+    #include <thread>     // std::thread
+    #include <type_traits> // std::is_signed
 
 inline static uint32_t digits10_alexandrescu_v3( uint64_t );
 #define digits10_fixed digits10_alexandrescu_v3
@@ -391,6 +395,44 @@ inline static uint32_t digits10_alexandrescu_v3( uint64_t );
     };
     const int NUM_I64_POW10 = sizeof(TEST_I64_POW10) / sizeof(TEST_I64_POW10[0]);
 
+// -------------------- fixed point --------------------
+
+    // number / 10^scale, then with the trailing zeros of the fraction trimmed
+    struct FixedKeyVal
+    {
+        int64_t     number;
+        uint32_t    scale;
+        const char *pText;
+        const char *pTrimmed;
+    };
+
+    const FixedKeyVal TEST_FIXED_POINT[] = {
+          {                        0,  2, "0.00"                 , "0"                     }
+        , {                       +1,  2, "0.01"                 , "0.01"                  }
+        , {                       -1,  2, "-0.01"                , "-0.01"                 }
+        , {                      +10,  2, "0.10"                 , "0.1"                   }
+        , {                      -10,  2, "-0.10"                , "-0.1"                  }
+        , {                      +99,  2, "0.99"                 , "0.99"                  }
+        , {                     +100,  2, "1.00"                 , "1"                     }
+        , {                     -100,  2, "-1.00"                , "-1"                    }
+        , {                     +101,  2, "1.01"                 , "1.01"                  }
+        , {                   -12345,  2, "-123.45"              , "-123.45"               }
+        , {                  +123450,  3, "123.450"              , "123.45"                }
+        , {                       +5,  9, "0.000000005"          , "0.000000005"           }
+        , {               -500000000,  9, "-0.500000000"         , "-0.5"                  }
+        , {               +999999999,  9, "0.999999999"          , "0.999999999"           }
+        , {              +1000000000,  9, "1.000000000"          , "1"                     }
+        , {      +100000000000000000, 18, "0.100000000000000000" , "0.1"                   }
+        , {     +1000000000000000000, 18, "1.000000000000000000" , "1"                     }
+        , {     +9223372036854775807,  2, "92233720368547758.07" , "92233720368547758.07"  }
+        , { -9223372036854775807 - 1,  2, "-92233720368547758.08", "-92233720368547758.08" }
+        , {     +9223372036854775807, 18, "9.223372036854775807" , "9.223372036854775807"  }
+        , { -9223372036854775807 - 1, 18, "-9.223372036854775808", "-9.223372036854775808" }
+        , {                   +12345,  0, "12345"                , "12345"                 }
+        , {                      -10,  0, "-10"                  , "-10"                   }
+    };
+    const int NUM_FIXED_POINT = sizeof(TEST_FIXED_POINT) / sizeof(TEST_FIXED_POINT[0]);
+
 // -------------------- uint64_t --------------------
 
     const uint64_t TEST_U64_NINES[] = {
@@ -402,7 +444,7 @@ inline static uint32_t digits10_alexandrescu_v3( uint64_t );
                       +999999ULL, // 6, [ 5]
                      +9999999ULL, // 7, [ 6]
                     +99999999ULL, // 8, [ 7]
-                   +999999999ULL  // 9, [ 8]
+                   +999999999ULL, // 9, [ 8]
                   +9999999999ULL, //10, [ 9] + 2^31 - 1 = +2147483647
                  +99999999999ULL, //11, [10]
                 +999999999999ULL, //12, [11]
@@ -519,6 +561,252 @@ inline static uint32_t digits10_alexandrescu_v3( uint64_t );
     };
     const int NUM_U64_POW10 = sizeof(TEST_U64_POW10) / sizeof(uint64_t);
 
+// -------------------- unsigned __int128 --------------------
+#if NUMDIGITS_INT128
+
+    // There are no 128-bit literals so the numbers are split into hi:lo and the expected answer embedded
+    struct U128KeyVal
+    {
+        uint64_t hi;
+        uint64_t lo;
+        int      expect;
+    };
+
+    const U128KeyVal TEST_U128_NINES[] = {
+        { 0x0000000000000000ull, 0x0000000000000009ull,  1 }, // 10^1 - 1
+        { 0x0000000000000000ull, 0x0000000000000063ull,  2 }, // 10^2 - 1
+        { 0x0000000000000000ull, 0x00000000000003E7ull,  3 }, // 10^3 - 1
+        { 0x0000000000000000ull, 0x000000000000270Full,  4 }, // 10^4 - 1
+        { 0x0000000000000000ull, 0x000000000001869Full,  5 }, // 10^5 - 1
+        { 0x0000000000000000ull, 0x00000000000F423Full,  6 }, // 10^6 - 1
+        { 0x0000000000000000ull, 0x000000000098967Full,  7 }, // 10^7 - 1
+        { 0x0000000000000000ull, 0x0000000005F5E0FFull,  8 }, // 10^8 - 1
+        { 0x0000000000000000ull, 0x000000003B9AC9FFull,  9 }, // 10^9 - 1
+        { 0x0000000000000000ull, 0x00000002540BE3FFull, 10 }, // 10^10 - 1
+        { 0x0000000000000000ull, 0x000000174876E7FFull, 11 }, // 10^11 - 1
+        { 0x0000000000000000ull, 0x000000E8D4A50FFFull, 12 }, // 10^12 - 1
+        { 0x0000000000000000ull, 0x000009184E729FFFull, 13 }, // 10^13 - 1
+        { 0x0000000000000000ull, 0x00005AF3107A3FFFull, 14 }, // 10^14 - 1
+        { 0x0000000000000000ull, 0x00038D7EA4C67FFFull, 15 }, // 10^15 - 1
+        { 0x0000000000000000ull, 0x002386F26FC0FFFFull, 16 }, // 10^16 - 1
+        { 0x0000000000000000ull, 0x016345785D89FFFFull, 17 }, // 10^17 - 1
+        { 0x0000000000000000ull, 0x0DE0B6B3A763FFFFull, 18 }, // 10^18 - 1
+        { 0x0000000000000000ull, 0x8AC7230489E7FFFFull, 19 }, // 10^19 - 1
+        { 0x0000000000000005ull, 0x6BC75E2D630FFFFFull, 20 }, // 10^20 - 1
+        { 0x0000000000000036ull, 0x35C9ADC5DE9FFFFFull, 21 }, // 10^21 - 1
+        { 0x000000000000021Eull, 0x19E0C9BAB23FFFFFull, 22 }, // 10^22 - 1
+        { 0x000000000000152Dull, 0x02C7E14AF67FFFFFull, 23 }, // 10^23 - 1
+        { 0x000000000000D3C2ull, 0x1BCECCEDA0FFFFFFull, 24 }, // 10^24 - 1
+        { 0x0000000000084595ull, 0x1614014849FFFFFFull, 25 }, // 10^25 - 1
+        { 0x000000000052B7D2ull, 0xDCC80CD2E3FFFFFFull, 26 }, // 10^26 - 1
+        { 0x00000000033B2E3Cull, 0x9FD0803CE7FFFFFFull, 27 }, // 10^27 - 1
+        { 0x00000000204FCE5Eull, 0x3E2502610FFFFFFFull, 28 }, // 10^28 - 1
+        { 0x00000001431E0FAEull, 0x6D7217CA9FFFFFFFull, 29 }, // 10^29 - 1
+        { 0x0000000C9F2C9CD0ull, 0x4674EDEA3FFFFFFFull, 30 }, // 10^30 - 1
+        { 0x0000007E37BE2022ull, 0xC0914B267FFFFFFFull, 31 }, // 10^31 - 1
+        { 0x000004EE2D6D415Bull, 0x85ACEF80FFFFFFFFull, 32 }, // 10^32 - 1
+        { 0x0000314DC6448D93ull, 0x38C15B09FFFFFFFFull, 33 }, // 10^33 - 1
+        { 0x0001ED09BEAD87C0ull, 0x378D8E63FFFFFFFFull, 34 }, // 10^34 - 1
+        { 0x0013426172C74D82ull, 0x2B878FE7FFFFFFFFull, 35 }, // 10^35 - 1
+        { 0x00C097CE7BC90715ull, 0xB34B9F0FFFFFFFFFull, 36 }, // 10^36 - 1
+        { 0x0785EE10D5DA46D9ull, 0x00F4369FFFFFFFFFull, 37 }, // 10^37 - 1
+        { 0x4B3B4CA85A86C47Aull, 0x098A223FFFFFFFFFull, 38 }, // 10^38 - 1
+    //  10^39 - 1 overflows unsigned __int128
+    };
+    const int NUM_U128_NINES = sizeof(TEST_U128_NINES) / sizeof(TEST_U128_NINES[0]);
+
+    const U128KeyVal TEST_U128_MINMAX[] = {
+        { 0x0000000000000000ull, 0x0000000000000000ull,  1 }, // 0
+        { 0xFFFFFFFFFFFFFFFFull, 0xFFFFFFFFFFFFFFFFull, 39 }, // 2^128 - 1
+    };
+    const int NUM_U128_MINMAX = sizeof(TEST_U128_MINMAX) / sizeof(TEST_U128_MINMAX[0]);
+
+    const U128KeyVal TEST_U128_POW2[] = {
+        { 0x0000000000000000ull, 0x0000000000000001ull,  1 }, // 2^0
+        { 0x0000000000000000ull, 0x0000000000000002ull,  1 }, // 2^1
+        { 0x0000000000000000ull, 0x0000000000000004ull,  1 }, // 2^2
+        { 0x0000000000000000ull, 0x0000000000000008ull,  1 }, // 2^3
+        { 0x0000000000000000ull, 0x0000000000000010ull,  2 }, // 2^4
+        { 0x0000000000000000ull, 0x0000000000000020ull,  2 }, // 2^5
+        { 0x0000000000000000ull, 0x0000000000000040ull,  2 }, // 2^6
+        { 0x0000000000000000ull, 0x0000000000000080ull,  3 }, // 2^7
+        { 0x0000000000000000ull, 0x0000000000000100ull,  3 }, // 2^8
+        { 0x0000000000000000ull, 0x0000000000000200ull,  3 }, // 2^9
+        { 0x0000000000000000ull, 0x0000000000000400ull,  4 }, // 2^10
+        { 0x0000000000000000ull, 0x0000000000000800ull,  4 }, // 2^11
+        { 0x0000000000000000ull, 0x0000000000001000ull,  4 }, // 2^12
+        { 0x0000000000000000ull, 0x0000000000002000ull,  4 }, // 2^13
+        { 0x0000000000000000ull, 0x0000000000004000ull,  5 }, // 2^14
+        { 0x0000000000000000ull, 0x0000000000008000ull,  5 }, // 2^15
+        { 0x0000000000000000ull, 0x0000000000010000ull,  5 }, // 2^16
+        { 0x0000000000000000ull, 0x0000000000020000ull,  6 }, // 2^17
+        { 0x0000000000000000ull, 0x0000000000040000ull,  6 }, // 2^18
+        { 0x0000000000000000ull, 0x0000000000080000ull,  6 }, // 2^19
+        { 0x0000000000000000ull, 0x0000000000100000ull,  7 }, // 2^20
+        { 0x0000000000000000ull, 0x0000000000200000ull,  7 }, // 2^21
+        { 0x0000000000000000ull, 0x0000000000400000ull,  7 }, // 2^22
+        { 0x0000000000000000ull, 0x0000000000800000ull,  7 }, // 2^23
+        { 0x0000000000000000ull, 0x0000000001000000ull,  8 }, // 2^24
+        { 0x0000000000000000ull, 0x0000000002000000ull,  8 }, // 2^25
+        { 0x0000000000000000ull, 0x0000000004000000ull,  8 }, // 2^26
+        { 0x0000000000000000ull, 0x0000000008000000ull,  9 }, // 2^27
+        { 0x0000000000000000ull, 0x0000000010000000ull,  9 }, // 2^28
+        { 0x0000000000000000ull, 0x0000000020000000ull,  9 }, // 2^29
+        { 0x0000000000000000ull, 0x0000000040000000ull, 10 }, // 2^30
+        { 0x0000000000000000ull, 0x0000000080000000ull, 10 }, // 2^31
+        { 0x0000000000000000ull, 0x0000000100000000ull, 10 }, // 2^32
+        { 0x0000000000000000ull, 0x0000000200000000ull, 10 }, // 2^33
+        { 0x0000000000000000ull, 0x0000000400000000ull, 11 }, // 2^34
+        { 0x0000000000000000ull, 0x0000000800000000ull, 11 }, // 2^35
+        { 0x0000000000000000ull, 0x0000001000000000ull, 11 }, // 2^36
+        { 0x0000000000000000ull, 0x0000002000000000ull, 12 }, // 2^37
+        { 0x0000000000000000ull, 0x0000004000000000ull, 12 }, // 2^38
+        { 0x0000000000000000ull, 0x0000008000000000ull, 12 }, // 2^39
+        { 0x0000000000000000ull, 0x0000010000000000ull, 13 }, // 2^40
+        { 0x0000000000000000ull, 0x0000020000000000ull, 13 }, // 2^41
+        { 0x0000000000000000ull, 0x0000040000000000ull, 13 }, // 2^42
+        { 0x0000000000000000ull, 0x0000080000000000ull, 13 }, // 2^43
+        { 0x0000000000000000ull, 0x0000100000000000ull, 14 }, // 2^44
+        { 0x0000000000000000ull, 0x0000200000000000ull, 14 }, // 2^45
+        { 0x0000000000000000ull, 0x0000400000000000ull, 14 }, // 2^46
+        { 0x0000000000000000ull, 0x0000800000000000ull, 15 }, // 2^47
+        { 0x0000000000000000ull, 0x0001000000000000ull, 15 }, // 2^48
+        { 0x0000000000000000ull, 0x0002000000000000ull, 15 }, // 2^49
+        { 0x0000000000000000ull, 0x0004000000000000ull, 16 }, // 2^50
+        { 0x0000000000000000ull, 0x0008000000000000ull, 16 }, // 2^51
+        { 0x0000000000000000ull, 0x0010000000000000ull, 16 }, // 2^52
+        { 0x0000000000000000ull, 0x0020000000000000ull, 16 }, // 2^53
+        { 0x0000000000000000ull, 0x0040000000000000ull, 17 }, // 2^54
+        { 0x0000000000000000ull, 0x0080000000000000ull, 17 }, // 2^55
+        { 0x0000000000000000ull, 0x0100000000000000ull, 17 }, // 2^56
+        { 0x0000000000000000ull, 0x0200000000000000ull, 18 }, // 2^57
+        { 0x0000000000000000ull, 0x0400000000000000ull, 18 }, // 2^58
+        { 0x0000000000000000ull, 0x0800000000000000ull, 18 }, // 2^59
+        { 0x0000000000000000ull, 0x1000000000000000ull, 19 }, // 2^60
+        { 0x0000000000000000ull, 0x2000000000000000ull, 19 }, // 2^61
+        { 0x0000000000000000ull, 0x4000000000000000ull, 19 }, // 2^62
+        { 0x0000000000000000ull, 0x8000000000000000ull, 19 }, // 2^63
+        { 0x0000000000000001ull, 0x0000000000000000ull, 20 }, // 2^64
+        { 0x0000000000000002ull, 0x0000000000000000ull, 20 }, // 2^65
+        { 0x0000000000000004ull, 0x0000000000000000ull, 20 }, // 2^66
+        { 0x0000000000000008ull, 0x0000000000000000ull, 21 }, // 2^67
+        { 0x0000000000000010ull, 0x0000000000000000ull, 21 }, // 2^68
+        { 0x0000000000000020ull, 0x0000000000000000ull, 21 }, // 2^69
+        { 0x0000000000000040ull, 0x0000000000000000ull, 22 }, // 2^70
+        { 0x0000000000000080ull, 0x0000000000000000ull, 22 }, // 2^71
+        { 0x0000000000000100ull, 0x0000000000000000ull, 22 }, // 2^72
+        { 0x0000000000000200ull, 0x0000000000000000ull, 22 }, // 2^73
+        { 0x0000000000000400ull, 0x0000000000000000ull, 23 }, // 2^74
+        { 0x0000000000000800ull, 0x0000000000000000ull, 23 }, // 2^75
+        { 0x0000000000001000ull, 0x0000000000000000ull, 23 }, // 2^76
+        { 0x0000000000002000ull, 0x0000000000000000ull, 24 }, // 2^77
+        { 0x0000000000004000ull, 0x0000000000000000ull, 24 }, // 2^78
+        { 0x0000000000008000ull, 0x0000000000000000ull, 24 }, // 2^79
+        { 0x0000000000010000ull, 0x0000000000000000ull, 25 }, // 2^80
+        { 0x0000000000020000ull, 0x0000000000000000ull, 25 }, // 2^81
+        { 0x0000000000040000ull, 0x0000000000000000ull, 25 }, // 2^82
+        { 0x0000000000080000ull, 0x0000000000000000ull, 25 }, // 2^83
+        { 0x0000000000100000ull, 0x0000000000000000ull, 26 }, // 2^84
+        { 0x0000000000200000ull, 0x0000000000000000ull, 26 }, // 2^85
+        { 0x0000000000400000ull, 0x0000000000000000ull, 26 }, // 2^86
+        { 0x0000000000800000ull, 0x0000000000000000ull, 27 }, // 2^87
+        { 0x0000000001000000ull, 0x0000000000000000ull, 27 }, // 2^88
+        { 0x0000000002000000ull, 0x0000000000000000ull, 27 }, // 2^89
+        { 0x0000000004000000ull, 0x0000000000000000ull, 28 }, // 2^90
+        { 0x0000000008000000ull, 0x0000000000000000ull, 28 }, // 2^91
+        { 0x0000000010000000ull, 0x0000000000000000ull, 28 }, // 2^92
+        { 0x0000000020000000ull, 0x0000000000000000ull, 28 }, // 2^93
+        { 0x0000000040000000ull, 0x0000000000000000ull, 29 }, // 2^94
+        { 0x0000000080000000ull, 0x0000000000000000ull, 29 }, // 2^95
+        { 0x0000000100000000ull, 0x0000000000000000ull, 29 }, // 2^96
+        { 0x0000000200000000ull, 0x0000000000000000ull, 30 }, // 2^97
+        { 0x0000000400000000ull, 0x0000000000000000ull, 30 }, // 2^98
+        { 0x0000000800000000ull, 0x0000000000000000ull, 30 }, // 2^99
+        { 0x0000001000000000ull, 0x0000000000000000ull, 31 }, // 2^100
+        { 0x0000002000000000ull, 0x0000000000000000ull, 31 }, // 2^101
+        { 0x0000004000000000ull, 0x0000000000000000ull, 31 }, // 2^102
+        { 0x0000008000000000ull, 0x0000000000000000ull, 32 }, // 2^103
+        { 0x0000010000000000ull, 0x0000000000000000ull, 32 }, // 2^104
+        { 0x0000020000000000ull, 0x0000000000000000ull, 32 }, // 2^105
+        { 0x0000040000000000ull, 0x0000000000000000ull, 32 }, // 2^106
+        { 0x0000080000000000ull, 0x0000000000000000ull, 33 }, // 2^107
+        { 0x0000100000000000ull, 0x0000000000000000ull, 33 }, // 2^108
+        { 0x0000200000000000ull, 0x0000000000000000ull, 33 }, // 2^109
+        { 0x0000400000000000ull, 0x0000000000000000ull, 34 }, // 2^110
+        { 0x0000800000000000ull, 0x0000000000000000ull, 34 }, // 2^111
+        { 0x0001000000000000ull, 0x0000000000000000ull, 34 }, // 2^112
+        { 0x0002000000000000ull, 0x0000000000000000ull, 35 }, // 2^113
+        { 0x0004000000000000ull, 0x0000000000000000ull, 35 }, // 2^114
+        { 0x0008000000000000ull, 0x0000000000000000ull, 35 }, // 2^115
+        { 0x0010000000000000ull, 0x0000000000000000ull, 35 }, // 2^116
+        { 0x0020000000000000ull, 0x0000000000000000ull, 36 }, // 2^117
+        { 0x0040000000000000ull, 0x0000000000000000ull, 36 }, // 2^118
+        { 0x0080000000000000ull, 0x0000000000000000ull, 36 }, // 2^119
+        { 0x0100000000000000ull, 0x0000000000000000ull, 37 }, // 2^120
+        { 0x0200000000000000ull, 0x0000000000000000ull, 37 }, // 2^121
+        { 0x0400000000000000ull, 0x0000000000000000ull, 37 }, // 2^122
+        { 0x0800000000000000ull, 0x0000000000000000ull, 38 }, // 2^123
+        { 0x1000000000000000ull, 0x0000000000000000ull, 38 }, // 2^124
+        { 0x2000000000000000ull, 0x0000000000000000ull, 38 }, // 2^125
+        { 0x4000000000000000ull, 0x0000000000000000ull, 38 }, // 2^126
+        { 0x8000000000000000ull, 0x0000000000000000ull, 39 }, // 2^127
+    };
+    const int NUM_U128_POW2 = sizeof(TEST_U128_POW2) / sizeof(TEST_U128_POW2[0]);
+
+    const U128KeyVal TEST_U128_POW10[] = {
+        { 0x0000000000000000ull, 0x0000000000000001ull,  1 }, // 10^0
+        { 0x0000000000000000ull, 0x000000000000000Aull,  2 }, // 10^1
+        { 0x0000000000000000ull, 0x0000000000000064ull,  3 }, // 10^2
+        { 0x0000000000000000ull, 0x00000000000003E8ull,  4 }, // 10^3
+        { 0x0000000000000000ull, 0x0000000000002710ull,  5 }, // 10^4
+        { 0x0000000000000000ull, 0x00000000000186A0ull,  6 }, // 10^5
+        { 0x0000000000000000ull, 0x00000000000F4240ull,  7 }, // 10^6
+        { 0x0000000000000000ull, 0x0000000000989680ull,  8 }, // 10^7
+        { 0x0000000000000000ull, 0x0000000005F5E100ull,  9 }, // 10^8
+        { 0x0000000000000000ull, 0x000000003B9ACA00ull, 10 }, // 10^9
+        { 0x0000000000000000ull, 0x00000002540BE400ull, 11 }, // 10^10
+        { 0x0000000000000000ull, 0x000000174876E800ull, 12 }, // 10^11
+        { 0x0000000000000000ull, 0x000000E8D4A51000ull, 13 }, // 10^12
+        { 0x0000000000000000ull, 0x000009184E72A000ull, 14 }, // 10^13
+        { 0x0000000000000000ull, 0x00005AF3107A4000ull, 15 }, // 10^14
+        { 0x0000000000000000ull, 0x00038D7EA4C68000ull, 16 }, // 10^15
+        { 0x0000000000000000ull, 0x002386F26FC10000ull, 17 }, // 10^16
+        { 0x0000000000000000ull, 0x016345785D8A0000ull, 18 }, // 10^17
+        { 0x0000000000000000ull, 0x0DE0B6B3A7640000ull, 19 }, // 10^18
+        { 0x0000000000000000ull, 0x8AC7230489E80000ull, 20 }, // 10^19
+        { 0x0000000000000005ull, 0x6BC75E2D63100000ull, 21 }, // 10^20
+        { 0x0000000000000036ull, 0x35C9ADC5DEA00000ull, 22 }, // 10^21
+        { 0x000000000000021Eull, 0x19E0C9BAB2400000ull, 23 }, // 10^22
+        { 0x000000000000152Dull, 0x02C7E14AF6800000ull, 24 }, // 10^23
+        { 0x000000000000D3C2ull, 0x1BCECCEDA1000000ull, 25 }, // 10^24
+        { 0x0000000000084595ull, 0x161401484A000000ull, 26 }, // 10^25
+        { 0x000000000052B7D2ull, 0xDCC80CD2E4000000ull, 27 }, // 10^26
+        { 0x00000000033B2E3Cull, 0x9FD0803CE8000000ull, 28 }, // 10^27
+        { 0x00000000204FCE5Eull, 0x3E25026110000000ull, 29 }, // 10^28
+        { 0x00000001431E0FAEull, 0x6D7217CAA0000000ull, 30 }, // 10^29
+        { 0x0000000C9F2C9CD0ull, 0x4674EDEA40000000ull, 31 }, // 10^30
+        { 0x0000007E37BE2022ull, 0xC0914B2680000000ull, 32 }, // 10^31
+        { 0x000004EE2D6D415Bull, 0x85ACEF8100000000ull, 33 }, // 10^32
+        { 0x0000314DC6448D93ull, 0x38C15B0A00000000ull, 34 }, // 10^33
+        { 0x0001ED09BEAD87C0ull, 0x378D8E6400000000ull, 35 }, // 10^34
+        { 0x0013426172C74D82ull, 0x2B878FE800000000ull, 36 }, // 10^35
+        { 0x00C097CE7BC90715ull, 0xB34B9F1000000000ull, 37 }, // 10^36
+        { 0x0785EE10D5DA46D9ull, 0x00F436A000000000ull, 38 }, // 10^37
+        { 0x4B3B4CA85A86C47Aull, 0x098A224000000000ull, 39 }, // 10^38
+    };
+    const int NUM_U128_POW10 = sizeof(TEST_U128_POW10) / sizeof(TEST_U128_POW10[0]);
+
+    // Bit patterns, the expected answer includes the '-'
+    const U128KeyVal TEST_I128_MINMAX[] = {
+        { 0x8000000000000000ull, 0x0000000000000000ull, 40 }, // -2^127
+        { 0x8000000000000000ull, 0x0000000000000001ull, 40 }, // -2^127 + 1
+        { 0xFFFFFFFFFFFFFFFFull, 0xFFFFFFFFFFFFFFFFull,  2 }, // -1
+        { 0x0000000000000000ull, 0x0000000000000000ull,  1 }, // 0
+        { 0x7FFFFFFFFFFFFFFFull, 0xFFFFFFFFFFFFFFFFull, 39 }, // +2^127 - 1
+    };
+    const int NUM_I128_MINMAX = sizeof(TEST_I128_MINMAX) / sizeof(TEST_I128_MINMAX[0]);
+#endif // NUMDIGITS_INT128
+
     typedef int      (*NumDigitsIntFuncPtr)(int     );
     typedef int32_t  (*NumDigitsI64FuncPtr)(int64_t );
     typedef uint32_t (*NumDigitsU64FuncPtr)(uint64_t);
@@ -526,6 +814,24 @@ inline static uint32_t digits10_alexandrescu_v3( uint64_t );
     static void validate_table_int( const IntKeyVal*aNumbers, int nNumbers, const char *pDescription, NumDigitsIntFuncPtr pFunc );
     static void validate_table_i64( const int64_t  *aNumbers, int nNumbers, const char *pDescription, NumDigitsI64FuncPtr pFunc );
     static void validate_table_u64( const uint64_t *aNumbers, int nNumbers, const char *pDescription, NumDigitsU64FuncPtr pFunc );
+#if NUMDIGITS_INT128
+    typedef uint32_t (*NumDigitsU128FuncPtr)(unsigned __int128);
+    typedef int32_t  (*NumDigitsI128FuncPtr)(__int128);
+
+    static void validate_table_u128( const U128KeyVal *aNumbers, int nNumbers, const char *pDescription, NumDigitsU128FuncPtr pFunc );
+    static void validate_table_i128( const U128KeyVal *aNumbers, int nNumbers, const char *pDescription, NumDigitsI128FuncPtr pFunc, bool bBothSigns );
+#endif
+    typedef size_t (*NumDigitsBigIntFuncPtr)( const uint64_t *, size_t );
+
+    static bool validate_bigint( const std::vector<uint64_t>& aLimbs, NumDigitsBigIntFuncPtr pFunc );
+
+    static bool validate_write( const char *pActual, int nActual, const char *pExpect );
+
+    typedef int (*NumDigitsRadixU64FuncPtr)( uint64_t );
+    typedef int (*NumDigitsRadixI64FuncPtr)( int64_t  );
+    static void validate_table_batch( const IntKeyVal*aNumbers, int nNumbers, const char *pDescription, NumDigitsBatchFuncPtr pFunc );
+    static void validate_table_batch_i64( const int64_t  *aNumbers, int nNumbers, const char *pDescription, NumDigitsBatchI64FuncPtr pFunc );
+    static void validate_table_batch_u64( const uint64_t *aNumbers, int nNumbers, const char *pDescription, NumDigitsBatchU64FuncPtr pFunc );
 
 // ========================================
     enum CategoryFlags_e
@@ -534,7 +840,13 @@ inline static uint32_t digits10_alexandrescu_v3( uint64_t );
         , CATEGORY_I64 = (1 << 1)
         , CATEGORY_U64 = (1 << 2)
         , CATEGORY_ORG = (1 << 3)
-        , CATEGORY_ALL = CATEGORY_INT | CATEGORY_I64 | CATEGORY_U64 | CATEGORY_ORG
+        , CATEGORY_BATCH = (1 << 4)
+        , CATEGORY_128 = (1 << 5)
+        , CATEGORY_BIG = (1 << 6)
+        , CATEGORY_WRITE = (1 << 7)
+        , CATEGORY_RADIX = (1 << 8)
+        , CATEGORY_FLOAT = (1 << 9)
+        , CATEGORY_ALL = CATEGORY_INT | CATEGORY_I64 | CATEGORY_U64 | CATEGORY_ORG | CATEGORY_BATCH | CATEGORY_128 | CATEGORY_BIG | CATEGORY_WRITE | CATEGORY_RADIX | CATEGORY_FLOAT
         , CATEGORY_NONE = 0
     };
           int   g_bCategoryTests   = CATEGORY_ALL;
@@ -577,6 +889,36 @@ void initialize( int nArg, char *aArg[] )
                     bSpecifiedTests = true;
                 }
                 else
+                if (strcmp( pArg, "-batch") == 0) {
+                    bVerificationTests |= CATEGORY_BATCH;
+                    bSpecifiedTests = true;
+                }
+                else
+                if (strcmp( pArg, "-128") == 0) {
+                    bVerificationTests |= CATEGORY_128;
+                    bSpecifiedTests = true;
+                }
+                else
+                if (strcmp( pArg, "-big") == 0) {
+                    bVerificationTests |= CATEGORY_BIG;
+                    bSpecifiedTests = true;
+                }
+                else
+                if (strcmp( pArg, "-write") == 0) {
+                    bVerificationTests |= CATEGORY_WRITE;
+                    bSpecifiedTests = true;
+                }
+                else
+                if (strcmp( pArg, "-radix") == 0) {
+                    bVerificationTests |= CATEGORY_RADIX;
+                    bSpecifiedTests = true;
+                }
+                else
+                if (strcmp( pArg, "-float") == 0) {
+                    bVerificationTests |= CATEGORY_FLOAT;
+                    bSpecifiedTests = true;
+                }
+                else
                 if( strncmp( pArg, "-tests=", 7 ) == 0) {
                     g_pCategoryInclude = pArg + 7;
                     if (strcmp( g_pCategoryInclude, "?" ) == 0)
@@ -594,6 +936,12 @@ void initialize( int nArg, char *aArg[] )
         if (g_bCategoryTests & CATEGORY_I64) printf( "\ti64\n" );
         if (g_bCategoryTests & CATEGORY_U64) printf( "\tu64\n" );
         if (g_bCategoryTests & CATEGORY_ORG) printf( "\torg\n" );
+        if (g_bCategoryTests & CATEGORY_BATCH) printf( "\tbatch\n" );
+        if (g_bCategoryTests & CATEGORY_128) printf( "\t128\n" );
+        if (g_bCategoryTests & CATEGORY_BIG) printf( "\tbig\n" );
+        if (g_bCategoryTests & CATEGORY_WRITE) printf( "\twrite\n" );
+        if (g_bCategoryTests & CATEGORY_RADIX) printf( "\tradix\n" );
+        if (g_bCategoryTests & CATEGORY_FLOAT) printf( "\tfloat\n" );
     printf( "Category Includ: %s\n", g_pCategoryInclude );
     printf( "Category Print : %d\n", g_bCategoryPrint );
 #endif
@@ -648,6 +996,31 @@ void test_original_digits10()
     printf( "\n" );
 }
 
+// numdigits<T>() is constexpr so the narrow widths are verified at compile time
+static_assert( numdigits<  int8_t>(   INT8_MIN ) ==  4 && numdigits<  int8_t>(   INT8_MAX ) ==  3, "int8_t"   );
+static_assert( numdigits< uint8_t>(          9 ) ==  1 && numdigits< uint8_t>(  UINT8_MAX ) ==  3, "uint8_t"  );
+static_assert( numdigits< int16_t>(  INT16_MIN ) ==  6 && numdigits< int16_t>(  INT16_MAX ) ==  5, "int16_t"  );
+static_assert( numdigits<uint16_t>(      9'999 ) ==  4 && numdigits<uint16_t>( UINT16_MAX ) ==  5, "uint16_t" );
+static_assert( numdigits< int32_t>(  INT32_MIN ) == 11 && numdigits<uint32_t>( UINT32_MAX ) == 10, "int32_t"  );
+static_assert( numdigits< int64_t>(  INT64_MIN ) == 20 && numdigits<uint64_t>( UINT64_MAX ) == 20, "int64_t"  );
+static_assert( max_digits<  int8_t>::value ==  4 && max_digits< uint8_t>::value ==  3, "max_digits 8"  );
+static_assert( max_digits< int16_t>::value ==  6 && max_digits<uint16_t>::value ==  5, "max_digits 16" );
+static_assert( max_digits< int32_t>::value == 11 && max_digits<uint32_t>::value == 10, "max_digits 32" );
+static_assert( max_digits< int64_t>::value == 20 && max_digits<uint64_t>::value == 20, "max_digits 64" );
+// The generated trees are constexpr too
+static_assert( digits10_tree_eval<Digits10_Tree_Small32  >( UINT32_MAX ) == 10 && digits10_tree_eval<Digits10_Tree_Small32  >( 0 ) == 1, "tree small32"   );
+static_assert( digits10_tree_eval<Digits10_Tree_Uniform32>( 999'999'999 ) ==  9 && digits10_tree_eval<Digits10_Tree_Uniform32>( 9 ) == 1, "tree uniform32" );
+static_assert( digits10_tree_eval<Digits10_Tree_Small64  >( UINT64_MAX ) == 20 && digits10_tree_eval<Digits10_Tree_Small64  >( 10 ) == 2, "tree small64"   );
+static_assert( numdigits< 2>( UINT64_MAX ) == 64 && numdigits< 2>(  INT64_MIN ) == 65 && numdigits< 2>( 0 ) == 1, "base 2"  );
+static_assert( numdigits< 3>( UINT64_MAX ) == 41 && numdigits< 3>(  UINT8_MAX ) ==  6 && numdigits< 3>( 8 ) == 2, "base 3"  );
+static_assert( numdigits< 8>( UINT64_MAX ) == 22 && numdigits< 8>(  INT32_MIN ) == 12 && numdigits< 8>( 8 ) == 2, "base 8"  );
+static_assert( numdigits<16>( UINT64_MAX ) == 16 && numdigits<16>(  INT64_MIN ) == 17 && numdigits<16>(15 ) == 1, "base 16" );
+static_assert( numdigits<36>( UINT64_MAX ) == 13 && numdigits<36>( UINT32_MAX ) ==  7 && numdigits<36>(36 ) == 2, "base 36" );
+
+static_assert( digits10_separators(  1,  3 ) == 0 && digits10_separators(  4, 3 ) == 1 && digits10_separators( 20, 3 ) == 6, "thousands" );
+static_assert( digits10_separators( 20,  1 ) == 19 && digits10_separators( 20, 0 ) == 0 && digits10_separators( 20, 19 ) == 1, "group" );
+static_assert( digits10_separators( 20, 20 ) ==  0 && digits10_separators( 20, 21 ) == 0 && digits10_separators( 20, UINT32_MAX ) == 0, "group >= 20" );
+
 void test_int( NumDigitsIntFuncPtr pFunc )
 {
     validate_table_int( TEST_INT_MINMAX, NUM_INT_MINMAX, "min,0,max"   , pFunc );
@@ -672,197 +1045,1336 @@ void test_u64( NumDigitsU64FuncPtr pFunc )
     validate_table_u64( TEST_U64_POW10 , NUM_U64_POW10 , "powers of 10", pFunc );
 }
 
-// ========================================
-void validate_table_int( const IntKeyVal *aNumbers, int nNumbers, const char *pDescription, NumDigitsIntFuncPtr pFunc )
+// Each length 1 .. 20 once through every instrumented 64-bit ladder.
+// pohoreski_v1/v2 recurse above 12 digits and must still count one call per length.
+void test_exit_profile()
+{
+#ifdef NUMDIGITS_PROFILE
+    const struct { NumDigitsU64FuncPtr pFunc; const char *pName; } aFuncs[] = {
+          { numdigits10_uint64        , "numdigits10_uint64"         }
+        , { numdigits10_reverse_uint64, "numdigits10_reverse_uint64" }
+        , { digits10_pohoreski_v1     , "digits10_pohoreski_v1"      }
+        , { digits10_pohoreski_v2     , "digits10_pohoreski_v2"      }
+    };
+
+    for (const auto& func : aFuncs) {
+        uint64_t aBefore[ NUMDIGITS_PROFILE_DIGITS ];
+        uint64_t aAfter [ NUMDIGITS_PROFILE_DIGITS ];
+
+        numdigits_profile_flush();
+        numdigits_profile_lengths( func.pName, aBefore );
+        for (int digits = 1; digits <= 20; digits++)
+            func.pFunc( Pow10_constexpr[ digits - 1 ] );
+        numdigits_profile_flush();
+        numdigits_profile_lengths( func.pName, aAfter );
+
+        bool status = true;
+        for (int digits = 0; digits < NUMDIGITS_PROFILE_DIGITS; digits++) {
+            const uint64_t actual = aAfter[ digits ] - aBefore[ digits ];
+            const uint64_t expect = (digits > 0);
+            if (actual != expect) {
+                status = false;
+                printf( "%s digits %2d: %" PRIu64 " != %" PRIu64 " %s\n", func.pName, digits, actual, expect, STATUS[status] );
+            }
+        }
+        printf( "%s %s\n", STATUS[status], func.pName );
+    }
+#else
+    printf( "SKIP not built with -DNUMDIGITS_PROFILE\n" );
+#endif
+}
+
+// Reference significant digits: sprintf() then keep the first digits, rounding half up on the text.
+// 0 if the rounded value doesn't fit in uint64_t.
+static uint64_t significant_reference( uint64_t n, uint32_t digits, bool bRound )
+{
+    char text[ 32 ];
+    const int len = sprintf( text + 1, "%" PRIu64, n );
+    text[0] = '0'; // room for the carry
+    if ((int)digits >= len)
+        return n;
+
+    const bool bUp = bRound && (text[ 1 + digits ] >= '5');
+    memset( text + 1 + digits, '0', len - digits );
+    for (int i = (int)digits; bUp; i--) {
+        if (text[ i ] == '9')
+            text[ i ] = '0';
+        else {
+            text[ i ]++;
+            break;
+        }
+    }
+
+    const char *pText = (text[0] == '0') ? text + 1 : text;
+    if ((strlen( pText ) > 20) || ((strlen( pText ) == 20) && (strcmp( pText, "18446744073709551615" ) > 0)))
+        return 0;
+    return strtoull( pText, nullptr, 10 );
+}
+
+// The u64 tables plus m * 10^k +/- 1 for the rounding ties, at every significant digit count
+void test_magnitude()
 {
+    std::vector<uint64_t> aNumbers;
+    for (const auto& table : { std::make_pair( TEST_U64_MINMAX, NUM_U64_MINMAX ), std::make_pair( TEST_U64_NINES, NUM_U64_NINES ),
+                               std::make_pair( TEST_U64_POW2  , NUM_U64_POW2   ), std::make_pair( TEST_U64_POW10, NUM_U64_POW10 ) })
+        aNumbers.insert( aNumbers.end(), table.first, table.first + table.second );
+    for (uint64_t pow = 1; pow <= UINT64_MAX / 100; pow *= 10)
+        for (uint64_t m : { 10, 15, 45, 50, 95, 99, 184 })
+            for (uint64_t delta : { -1ull, 0ull, 1ull })
+                aNumbers.push_back( m * pow + delta );
+
     bool status = true;
+    for (uint64_t n : aNumbers) {
+        // Exact powers of 10 with overflow for the ceiling
+        uint32_t floorLog = 0, ceilLog = 0;
+        uint64_t floorPow = 1, ceilPow = 1;
+        while (floorPow <= n / 10) {
+            floorPow *= 10;
+            floorLog++;
+        }
+        while (ceilPow < n) {
+            ceilPow = (ceilPow > UINT64_MAX / 10) ? 0 : ceilPow * 10;
+            ceilLog++;
+            if (!ceilPow)
+                break;
+        }
 
-    // We have a few choices to use as our reference version to compare against:
-    //   numdigits_dumb_int64( (int64_t)n );
-    //   numdigits_dumb_sprintf_strlen
-    //   numdigits_if_naive
-    //   numdigits10_i32
-    // But couldn't/shouldn't trust any of those
-    // so we embed the expected answer along with the test number.
-    for (int iNumber = 0; iNumber < nNumbers; iNumber++ ) {
-        int      n = aNumbers[ iNumber ].number;
-        int actual = pFunc( n );
-        int expect = aNumbers[ iNumber ].expect;
-        if (actual != expect) {
+        if ((floor_log10( n ) != floorLog) || (ceil_log10( n ) != ceilLog) || (pow10_floor( n ) != floorPow) || (pow10_ceil( n ) != ceilPow)) {
             status = false;
-            printf( "(%11d) Actual %2d != Expect %2d %s test [%2d]\n", n, actual, expect, STATUS[status], iNumber );
+            printf( "(%20" PRIu64 ") log10 %u %u pow10 %" PRIu64 " %" PRIu64 " %s\n", n, floor_log10( n ), ceil_log10( n ), pow10_floor( n ), pow10_ceil( n ), STATUS[status] );
+        }
+
+        for (uint32_t digits = 1; digits <= 21; digits++) {
+            const bool     fits     = (digits >= 20) || (n < Pow10_constexpr[ digits ]);
+            const uint64_t truncate = significant_reference( n, digits, false );
+            const uint64_t round    = significant_reference( n, digits, true  );
+            if ((fits_digits10( n, digits ) != fits) || (truncate_significant10( n, digits ) != truncate) || (round_significant10( n, digits ) != round)) {
+                status = false;
+                printf( "(%20" PRIu64 ") %2u digits: truncate %" PRIu64 " != %" PRIu64 ", round %" PRIu64 " != %" PRIu64 " %s\n"
+                    , n, digits, truncate_significant10( n, digits ), truncate, round_significant10( n, digits ), round, STATUS[status] );
+            }
         }
     }
-    printf( "%s %s\n", STATUS[status], pDescription );
+    printf( "%s %s\n", STATUS[status], "log10, pow10, significant digits" );
 }
 
-void validate_table_i64(const int64_t* aNumbers, int nNumbers, const char* pDescription, NumDigitsI64FuncPtr pFunc)
+// The int -> float conversion rounds up to the next power of 2 just below it,
+// so every n within 4096 of a power of 2 (and 10) against the reference
+void test_fpexp_rounding()
 {
-    bool status = true;
+    std::vector<uint64_t> aNumbers;
+    for (int bits = 1; bits <= 64; bits++)
+        for (uint64_t delta = 1; delta <= 4096; delta++) {
+            const uint64_t pow2 = (bits == 64) ? 0 : (1ull << bits); // 2^64 wraps to 0
+            aNumbers.push_back( pow2 - delta );
+            if (bits < 64)
+                aNumbers.push_back( pow2 + delta - 1 );
+        }
+    for (int digits = 1; digits < 20; digits++)
+        for (uint64_t delta = 0; delta <= 4096; delta++) {
+            aNumbers.push_back( Pow10_constexpr[ digits ] - delta );
+            aNumbers.push_back( Pow10_constexpr[ digits ] + delta );
+        }
 
-    for (int iNumber = 0; iNumber < nNumbers; iNumber++ ) {
-        int64_t   n = aNumbers[ iNumber ];
-        int32_t actual = pFunc            ( n );
-        int32_t expect = numdigits10_int64( n );
-        if (actual != expect) {
+    bool status32 = true, status64 = true;
+    for (uint64_t n : aNumbers) {
+        const uint32_t expect = numdigits10_uint64( n );
+        if (digits10_fpexp( n ) != expect) {
+            status64 = false;
+            printf( "(%20" PRIu64 ") %2u != %2u %s digits10_fpexp\n", n, digits10_fpexp( n ), expect, STATUS[status64] );
+        }
+        if ((n <= UINT32_MAX) && (digits10_fpexp_u32( (uint32_t)n ) != expect)) {
+            status32 = false;
+            printf( "(%20" PRIu64 ") %2u != %2u %s digits10_fpexp_u32\n", n, digits10_fpexp_u32( (uint32_t)n ), expect, STATUS[status32] );
+        }
+    }
+    printf( "%s %s\n", STATUS[status32], "digits10_fpexp_u32 near powers of 2 and 10" );
+    printf( "%s %s\n", STATUS[status64], "digits10_fpexp near powers of 2 and 10" );
+}
+
+// Several periods of each distribution: every result must be right across the switches
+// and the kernel at the end of each phase must be the one for that distribution,
+// or the branchless one where the calibration timed the ladder slower.
+void test_adaptive_shift()
+{
+    const struct { int nMin; int nMax; bool bNegate; bool bBitWidth; int iKernel; const char *pDescription; } aPhases[] = {
+          {             0,      9'999, false, false, NUMDIGITS_ADAPTIVE_SMALL     , "small"                       }
+        , { 1'000'000'000,  INT32_MAX, true , false, NUMDIGITS_ADAPTIVE_LARGE     , "large, both signs"           }
+        , {             0,  INT32_MAX, true , true , NUMDIGITS_ADAPTIVE_BRANCHLESS, "every bit width, both signs" }
+        , {             0,         99, true , false, NUMDIGITS_ADAPTIVE_SMALL     , "small, both signs"           }
+    };
+
+    const NumDigitsAdaptiveCalibration& calibration = numdigits_adaptive_calibration();
+    for (int iLadder = 0; iLadder < NUMDIGITS_ADAPTIVE_BRANCHLESS; iLadder++)
+        printf( "%s %.3f ns vs branchless %.3f ns on its own inputs\n",
+            NumDigits_Adaptive_Kernels[ iLadder ].pName, calibration.LadderNS[ iLadder ], calibration.BranchlessNS[ iLadder ] );
+
+    uint64_t seed = 1;
+    for (const auto& phase : aPhases) {
+        bool status = true;
+        for (int iCall = 0; iCall < 3 * NUMDIGITS_ADAPTIVE_PERIOD; iCall++ ) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull; // LCG
+            const uint32_t r = (uint32_t)(seed >> 32);
+            int n = phase.nMin + (int)(r % ((uint32_t)(phase.nMax - phase.nMin) + 1));
+            if (phase.bBitWidth)
+                n >>= (seed >> 8) % 31;
+            if (phase.bNegate && (seed & 0x80000000u))
+                n = -n;
+
+            const int actual = numdigits_adaptive( n );
+            const int expect = numdigits10_int  ( n );
+            if (actual != expect) {
+                status = false;
+                printf( "(%11d) %2d != %2d %s\n", n, actual, expect, STATUS[status] );
+                break;
+            }
+        }
+        const int   iExpect = ((phase.iKernel == NUMDIGITS_ADAPTIVE_BRANCHLESS) || calibration.LadderWins[ phase.iKernel ])
+                            ? phase.iKernel : NUMDIGITS_ADAPTIVE_BRANCHLESS;
+        const char *pExpect = NumDigits_Adaptive_Kernels[ iExpect ].pName;
+        const char *pActual = numdigits_adaptive_variant();
+        if (strcmp( pActual, pExpect ) != 0) {
             status = false;
-            printf( "(%11" PRId64 ") %2d != %2d %s test [%2d]\n", n, actual, expect, STATUS[status], iNumber );
+            printf( "%s != %s %s\n", pActual, pExpect, STATUS[status] );
         }
+        printf( "%s %s -> %s\n", STATUS[status], phase.pDescription, pActual );
     }
-    printf( "%s %s\n", STATUS[status], pDescription );
 }
 
-void validate_table_u64( const uint64_t* aNumbers, int nNumbers, const char* pDescription, NumDigitsU64FuncPtr pFunc )
+// 16-bit is small enough to test every number
+void test_lut16()
 {
     bool status = true;
+    for (uint32_t n = 0; n < 65536; n++ ) {
+        const int actual = (int) digits10_lut16( (uint16_t)n );
+        const int expect = numdigits<uint16_t>( (uint16_t)n );
+        if (actual != expect) {
+            status = false;
+            printf( "(%5u) %2d != %2d %s\n", n, actual, expect, STATUS[status] );
+        }
+    }
+    printf( "%s all uint16_t\n", STATUS[status] );
 
-    for (int iNumber = 0; iNumber < nNumbers; iNumber++ ) {
-        uint64_t   n = aNumbers[ iNumber ];
-        int32_t actual = pFunc            (  n );
-        int32_t expect = numdigits10_uint64( n );
+    status = true;
+    for (int32_t n = INT16_MIN; n <= INT16_MAX; n++ ) {
+        const int actual = numdigits_lut16( (int16_t)n );
+        const int expect = numdigits<int16_t>( (int16_t)n );
         if (actual != expect) {
             status = false;
-            printf( "(%20" PRIu64 ") %2d != %2d %s test [%2d]\n", n, actual, expect, STATUS[status], iNumber );
+            printf( "(%6d) %2d != %2d %s\n", n, actual, expect, STATUS[status] );
         }
     }
-    printf( "%s %s\n", STATUS[status], pDescription );
+    printf( "%s all int16_t\n", STATUS[status] );
 }
 
-// ========================================
-void verify_int()
+// The first and last number of every high half, since the high table is only exact up to the fix-up compare
+void test_lut32_halves()
 {
-    const char *CATEGORY = "int";
+    bool status = true;
+    for (uint32_t hi = 0; hi < 65536; hi++ ) {
+        for (uint32_t n : { hi << 16, (hi << 16) | 0xFFFF }) {
+            const int actual = (int) digits10_lut32( n );
+            const int expect = numdigits<uint32_t>( n );
+            if (actual != expect) {
+                status = false;
+                printf( "(%10u) %2d != %2d %s\n", n, actual, expect, STATUS[status] );
+            }
+        }
+    }
+    printf( "%s first,last of every high half\n", STATUS[status] );
+}
 
-    struct FuncDescInt
+#if NUMDIGITS_INT128
+void test_u128( NumDigitsU128FuncPtr pFunc )
+{
+    validate_table_u128( TEST_U128_MINMAX, NUM_U128_MINMAX, "min,0,max"   , pFunc );
+    validate_table_u128( TEST_U128_NINES , NUM_U128_NINES , "nines"       , pFunc );
+    validate_table_u128( TEST_U128_POW2  , NUM_U128_POW2  , "powers of 2" , pFunc );
+    validate_table_u128( TEST_U128_POW10 , NUM_U128_POW10 , "powers of 10", pFunc );
+}
+
+void test_i128( NumDigitsI128FuncPtr pFunc )
+{
+    validate_table_i128( TEST_I128_MINMAX, NUM_I128_MINMAX, "min,0,max"   , pFunc, false );
+    validate_table_i128( TEST_U128_NINES , NUM_U128_NINES , "nines"       , pFunc, true  );
+    validate_table_i128( TEST_U128_POW2  , NUM_U128_POW2  , "powers of 2" , pFunc, true  );
+    validate_table_i128( TEST_U128_POW10 , NUM_U128_POW10 , "powers of 10", pFunc, true  );
+}
+#endif
+
+// Big integers are too long for tables so they are generated and compared against numdigits10_bigint()
+void test_bigint( NumDigitsBigIntFuncPtr pFunc )
+{
+    const size_t MAX_BITS   = 4096;
+    const size_t MAX_DIGITS = 1234; // 10^1233 < 2^4096
+    bool status;
+
+    status = true;
     {
-        NumDigitsIntFuncPtr pFunc;
-        const char         *pName;
-    };
+        std::vector<uint64_t> x;
+        status &= validate_bigint( x, pFunc ); // no limbs
+        x.assign( 4, 0 );
+        status &= validate_bigint( x, pFunc ); // all zero limbs
+        x[0] = 1;
+        status &= validate_bigint( x, pFunc ); // leading zero limbs
+        x.assign( 64, ~0ull );
+        status &= validate_bigint( x, pFunc ); // 2^4096 - 1
+    }
+    printf( "%s %s\n", STATUS[status], "min,0,max" );
 
-    FuncDescInt aFuncs[] = {
-          { numdigits_alexandrescu_v1          , "alexandrescu_v1"           }
-        , { numdigits_alexandrescu_pohoreski_v2, "alexandrescu_pohoreski_v2" }
-        , { numdigits_alexandrescu_pohoreski_v3, "alexandrescu_pohoreski_v3" }
-        , { numdigits_alink_buggy_v1           , "alink_buggy_v1"            }
-        , { numdigits_alink_buggy_v2           , "alink_buggy_v2"            }
-        , { numdigits_alink_fixed_v1a          , "alink_fixed_v1a"           }
-        , { numdigits_alink_fixed_v1b          , "alink_fixed_v1b"           }
-        , { numdigits_alink_fixed_v2a          , "alink_fixed_v2a"           }
-        , { numdigits_alink_fixed_v2b          , "alink_fixed_v2b"           }
-        , { numdigits_clifford_buggy           , "clifford_buggy"            }
-        , { numdigits_clifford_fixed           , "clifford_fixed"            }
-        , { numdigits_dagostino_pohoreski      , "dagostino_pohoreski"       }
-        , { numdigits_dumb_sprintf_strlen      , "dumb_sprintf_strlen"       }
-        , { numdigits_gabriel_v1a              , "gabriel_v1a"               }
-        , { numdigits_gabriel_v1b              , "gabriel_v1b"               }
-        , { numdigits_gabriel_v1c              , "gabriel_v1c"               }
-        , { numdigits_if_naive                 , "if_naive"                  }
-        , { numdigits_log                      , "log"                       }
-        , { numdigits_microsoft_itoa_strlen    , "microsoft_itoa_strlen"     }
-        , { numdigits_pohoreski_v1a            , "pohoreski_v1a"             }
-        , { numdigits_pohoreski_v1b            , "pohoreski_v1b"             }
-        , { numdigits_pohoreski_v2a            , "pohoreski_v2a"             }
-        , { numdigits_pohoreski_v2b            , "pohoreski_v2b"             }
-        , { numdigits_pohoreski_v3a            , "pohoreski_v3a"             }
-        , { numdigits_pohoreski_v3b            , "pohoreski_v3b"             }
-        , { numdigits_pohoreski_v4a            , "pohoreski_v4a"             }
-        , { numdigits_pohoreski_v4b            , "pohoreski_v4b"             }
-        , { numdigits_ransom                   , "ransom"                    }
-        , { numdigits10_int32                  , "reference_int32"           }
-        , { numdigits10_int                    , "reference_pow10_int"       }
-        , { numdigits10_mixed_int              , "reference_mixed_int"       }
-        , { numdigits_simple                   , "simple"                    }
-        , { numdigits_simple_reverse           , "simple_reverse"            }
-        , { numdigits_thomas                   , "thomas"                    }
-        , { numdigits_user42690_buggy          , "user42690_buggy"           }
-        , { numdigits_user42690_fixed_a        , "user42690_fixed_a"         }
-        , { numdigits_user42690_fixed_b        , "user42690_fixed_b"         }
-        , { numdigits_vitali                   , "vitali"                    }
-    };
-    const int nFuncs = sizeof(aFuncs) / sizeof(aFuncs[0]);
+    // 2^(bits-1) and 2^bits - 1 for every bit length
+    status = true;
+    for (size_t bits = 1; bits <= MAX_BITS; bits++ ) {
+        std::vector<uint64_t> x( (bits + 63) / 64, 0 );
+        x.back() = 1ull << ((bits - 1) % 64);
+        status &= validate_bigint( x, pFunc );
 
-    if (g_bCategoryPrint)
-        printf( "Available tests for '-%s' (%d):\n", CATEGORY, nFuncs );
-        for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
-            const char *pNextTestName = aFuncs[ iFunc ].pName;
-            printf( "    %s\n", pNextTestName );
-        }
+        for (uint64_t& limb : x)
+            limb = ~0ull;
+        if (bits % 64)
+            x.back() = (1ull << (bits % 64)) - 1;
+        status &= validate_bigint( x, pFunc );
+    }
+    printf( "%s %s\n", STATUS[status], "powers of 2" );
 
-    printf( "----------------------------------------\n\n" );
-    for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
-        const char *pNextTestName = aFuncs[ iFunc ].pName;
-        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
-        if (bRunTest) {
-            printf( "\n========== %s (%s) ==========\n", pNextTestName, CATEGORY );
-            test_int( aFuncs[ iFunc ].pFunc );
+    // 10^digits - 1, 10^digits, 10^digits + 1
+    status = true;
+    std::vector<uint64_t> pow10( 1, 1 );
+    for (size_t digits = 0; digits <= MAX_DIGITS; digits++ ) {
+        std::vector<uint64_t> x = pow10;
+        for (uint64_t& limb : x)
+            if (limb--) break;
+        status &= validate_bigint( x, pFunc );
+
+        status &= validate_bigint( pow10, pFunc );
+
+        x = pow10;
+        for (uint64_t& limb : x)
+            if (++limb) break;
+        status &= validate_bigint( x, pFunc );
+
+        uint64_t carry = 0;
+        for (uint64_t& limb : pow10) {
+            uint64_t hi;
+            const uint64_t lo = mul_u64( limb, 10, &hi );
+            limb  = lo + carry;
+            carry = hi + (limb < lo);
         }
+        if (carry)
+            pow10.push_back( carry );
     }
-    printf( "\n" );
+    printf( "%s %s\n", STATUS[status], "powers of 10" );
+
+    // Every thread has its own cache, so mixed bit lengths from several threads at once
+    const int NUM_THREADS = 4;
+    bool aStatus[ NUM_THREADS ];
+    std::vector<std::thread> aThreads;
+    for (int iThread = 0; iThread < NUM_THREADS; iThread++ )
+        aThreads.emplace_back( [iThread, &aStatus, pFunc]() {
+            aStatus[ iThread ] = true;
+            uint64_t seed = iThread + 1;
+            for (int i = 0; i < 500; i++ ) {
+                seed = seed * 6364136223846793005ull + 1442695040888963407ull; // LCG
+                std::vector<uint64_t> x( 1 + (seed >> 32) % (MAX_BITS / 64) );
+                for (uint64_t& limb : x) {
+                    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+                    limb = seed;
+                }
+                x.back() >>= seed % 64;
+                aStatus[ iThread ] &= validate_bigint( x, pFunc );
+            }
+        });
+    status = true;
+    for (int iThread = 0; iThread < NUM_THREADS; iThread++ ) {
+        aThreads[ iThread ].join();
+        status &= aStatus[ iThread ];
+    }
+    printf( "%s %s\n", STATUS[status], "mixed bit lengths, 4 threads" );
 }
 
-void verify_i64()
+// The writers are compared against sprintf() on the same tables as the digit counters.
+// The byte after the returned length must be untouched since the writers don't append a NUL.
+template <typename Key>
+struct WriteTable
 {
-    const char *CATEGORY = "i64";
-    struct FuncDescI64
-    {
-        NumDigitsI64FuncPtr pFunc;
-        const char         *pName;
-    };
+    const Key  *aNumbers;
+    int         nNumbers;
+    const char *pDescription;
+};
 
-    FuncDescI64 aFuncs[] = {
-          { numdigits10_int64                 , "numdigits10_int64"    }
-        , { numdigits_dumb_int64              , "numdigits_dumb_int64" }
-        , { numdigits_simple_int64            , "simple_int64"         }
-        , { numdigits_vitali_template<int64_t>, "vitali_int64"         }
-    };
-    const int nFuncs = sizeof(aFuncs) / sizeof(aFuncs[0]);
+static const WriteTable<IntKeyVal> WRITE_TABLES_INT[] = {
+      { TEST_INT_MINMAX, NUM_INT_MINMAX, "min,0,max"    }
+    , { TEST_INT_NINES , NUM_INT_NINES , "nines"        }
+    , { TEST_INT_POW2  , NUM_INT_POW2  , "powers of 2"  }
+    , { TEST_INT_POW10 , NUM_INT_POW10 , "powers of 10" }
+};
+static const WriteTable<int64_t> WRITE_TABLES_I64[] = {
+      { TEST_I64_MINMAX, NUM_I64_MINMAX, "min,0,max"    }
+    , { TEST_I64_NINES , NUM_I64_NINES , "nines"        }
+    , { TEST_I64_POW2  , NUM_I64_POW2  , "powers of 2"  }
+    , { TEST_I64_POW10 , NUM_I64_POW10 , "powers of 10" }
+};
+static const WriteTable<uint64_t> WRITE_TABLES_U64[] = {
+      { TEST_U64_MINMAX, NUM_U64_MINMAX, "min,0,max"    }
+    , { TEST_U64_NINES , NUM_U64_NINES , "nines"        }
+    , { TEST_U64_POW2  , NUM_U64_POW2  , "powers of 2"  }
+    , { TEST_U64_POW10 , NUM_U64_POW10 , "powers of 10" }
+};
 
-    if (g_bCategoryPrint)
-        printf( "Available tests for '-%s' (%d):\n", CATEGORY, nFuncs );
-        for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
-            const char *pNextTestName = aFuncs[ iFunc ].pName;
-            printf( "    %s\n", pNextTestName );
-        }
+// The tables for T, picked by overload; the int tables hold key/value pairs
+static const auto& write_tables( int      ) { return WRITE_TABLES_INT; }
+static const auto& write_tables( int64_t  ) { return WRITE_TABLES_I64; }
+static const auto& write_tables( uint64_t ) { return WRITE_TABLES_U64; }
 
-    printf( "----------------------------------------\n\n" );
-    for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
-        const char *pNextTestName = aFuncs[ iFunc ].pName;
-        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
-        if (bRunTest) {
-            printf( "\n========== %s (%s) ==========\n", aFuncs[ iFunc ].pName, CATEGORY );
-            test_i64( aFuncs[ iFunc ].pFunc );
+static int64_t  table_number( const IntKeyVal& key ) { return key.number; }
+static int64_t  table_number( int64_t  n )           { return n; }
+static uint64_t table_number( uint64_t n )           { return n; }
+
+template <typename T, typename F>
+void test_write( F pFunc )
+{
+    for (const auto& table : write_tables( T() )) {
+        bool status = true;
+        for (int iNumber = 0; iNumber < table.nNumbers; iNumber++ ) {
+            const T n = (T) table_number( table.aNumbers[ iNumber ] );
+            char actual[ 32 ], expect[ 32 ];
+            memset( actual, '#', sizeof(actual) );
+            if (std::is_signed<T>::value)
+                sprintf( expect, "%" PRId64, (int64_t) n );
+            else
+                sprintf( expect, "%" PRIu64, (uint64_t) n );
+            status &= validate_write( actual, (int)pFunc( actual, n ), expect );
         }
+        printf( "%s %s\n", STATUS[status], table.pDescription );
     }
-    printf( "\n" );
 }
 
-void verify_u64()
+// Reference grouping: sprintf() then a separator before every group of digits counted from the right
+static void group_reference( char *pGrouped, const char *pPlain, uint32_t group, const char *pSeparator )
 {
-    const char *CATEGORY = "u64";
-    struct FuncDescU64
-    {
-        NumDigitsU64FuncPtr pFunc;
-        const char         *pName;
+    const char  *pDigits = pPlain + (*pPlain == '-');
+    const size_t nDigits = strlen( pDigits );
+    if (*pPlain == '-')
+        *pGrouped++ = '-';
+    for (size_t i = 0; i < nDigits; i++) {
+        if (group && i && ((nDigits - i) % group == 0))
+            pGrouped += sprintf( pGrouped, "%s", pSeparator );
+        *pGrouped++ = pDigits[ i ];
+    }
+    *pGrouped = 0;
+}
+
+static bool validate_write_length( int nActual, const char *pExpect )
+{
+    const int nExpect = (int) strlen( pExpect );
+    if (nActual != nExpect) {
+        printf( "(%s) length %2d != %2d %s\n", pExpect, nActual, nExpect, STATUS[0] );
+        return false;
+    }
+    return true;
+}
+
+// Each separator style on the int, int64_t and uint64_t tables, both the length alone and the writer
+void test_write_grouped()
+{
+    const struct { uint32_t nGroup; const char *pSeparator; const char *pDescription; } aStyles[] = {
+          { 3, ","           , "',' every 3"    }
+        , { 3, "\xE2\x80\xAF", "U+202F every 3" }
+        , { 4, "_"           , "'_' every 4"    }
+        , { 2, "\xC2\xA0"    , "U+00A0 every 2" }
+        , { 1, "'"           , "'\'' every 1"   }
+        , { 0, ","           , "no grouping"    }
+        , { 7, " "           , "' ' every 7"    }
+        , { 19, ","          , "',' every 19"   }
+        , { 25, ","          , "',' every 25"   }
+    };
+    const struct { const IntKeyVal *aNumbers; int nNumbers; } aTablesInt[] = {
+        { TEST_INT_MINMAX, NUM_INT_MINMAX }, { TEST_INT_NINES, NUM_INT_NINES }, { TEST_INT_POW2, NUM_INT_POW2 }, { TEST_INT_POW10, NUM_INT_POW10 }
+    };
+    const struct { const int64_t *aNumbers; int nNumbers; } aTablesI64[] = {
+        { TEST_I64_MINMAX, NUM_I64_MINMAX }, { TEST_I64_NINES, NUM_I64_NINES }, { TEST_I64_POW2, NUM_I64_POW2 }, { TEST_I64_POW10, NUM_I64_POW10 }
+    };
+    const struct { const uint64_t *aNumbers; int nNumbers; } aTablesU64[] = {
+        { TEST_U64_MINMAX, NUM_U64_MINMAX }, { TEST_U64_NINES, NUM_U64_NINES }, { TEST_U64_POW2, NUM_U64_POW2 }, { TEST_U64_POW10, NUM_U64_POW10 }
     };
 
-    FuncDescU64 aFuncs[] = {
-          { numdigits10_uint64        , "numdigits10_uint64"         }
-        , { numdigits10_reverse_uint64, "numdigits10_reverse_uint64" }
+    for (const auto& style : aStyles) {
+        const uint32_t nBytes = (uint32_t) strlen( style.pSeparator );
+        bool status = true;
+        char plain[ 32 ], expect[ 96 ], actual[ 96 ];
+
+        for (const auto& table : aTablesInt)
+            for (int iNumber = 0; iNumber < table.nNumbers; iNumber++ ) {
+                const int n = table.aNumbers[ iNumber ].number;
+                sprintf( plain, "%d", n );
+                group_reference( expect, plain, style.nGroup, style.pSeparator );
+                memset( actual, '#', sizeof(actual) );
+                status &= validate_write( actual, numdigits_write_grouped( actual, n, style.nGroup, style.pSeparator, nBytes ), expect );
+                status &= validate_write_length( numdigits_grouped( n, style.nGroup, nBytes ), expect );
+            }
+        for (const auto& table : aTablesI64)
+            for (int iNumber = 0; iNumber < table.nNumbers; iNumber++ ) {
+                const int64_t n = table.aNumbers[ iNumber ];
+                sprintf( plain, "%" PRId64, n );
+                group_reference( expect, plain, style.nGroup, style.pSeparator );
+                memset( actual, '#', sizeof(actual) );
+                status &= validate_write( actual, numdigits_write_grouped_int64( actual, n, style.nGroup, style.pSeparator, nBytes ), expect );
+                status &= validate_write_length( numdigits_grouped_int64( n, style.nGroup, nBytes ), expect );
+            }
+        for (const auto& table : aTablesU64)
+            for (int iNumber = 0; iNumber < table.nNumbers; iNumber++ ) {
+                const uint64_t n = table.aNumbers[ iNumber ];
+                sprintf( plain, "%" PRIu64, n );
+                group_reference( expect, plain, style.nGroup, style.pSeparator );
+                memset( actual, '#', sizeof(actual) );
+                status &= validate_write( actual, (int)digits10_write_grouped( actual, n, style.nGroup, style.pSeparator, nBytes ), expect );
+                status &= validate_write_length( (int)digits10_grouped( n, style.nGroup, nBytes ), expect );
+            }
+        printf( "%s %s\n", STATUS[status], style.pDescription );
+    }
+}
+
+// Reference fixed point: sprintf() of the integer and the zero padded fraction, then trim
+static void fixed_point_reference( char *pText, int64_t n, uint32_t scale, bool bTrim )
+{
+    const uint64_t x = (n < 0) ? 0ull - (uint64_t)n : (uint64_t)n;
+    if (scale == 0) {
+        sprintf( pText, "%" PRId64, n );
+        return;
+    }
+
+    uint64_t pow10 = 1;
+    for (uint32_t i = 0; i < scale; i++)
+        pow10 *= 10;
+    const int len = sprintf( pText, "%s%" PRIu64 ".%0*" PRIu64, (n < 0) ? "-" : "", x / pow10, (int)scale, x % pow10 );
+    if (bTrim) {
+        char *pLast = pText + len - 1;
+        while (*pLast == '0')
+            *pLast-- = 0;
+        if (*pLast == '.')
+            *pLast = 0;
+    }
+}
+
+// The table first, then every int64_t table at every scale against sprintf()
+void test_write_fixed_point()
+{
+    bool status = true;
+    for (int iNumber = 0; iNumber < NUM_FIXED_POINT; iNumber++ ) {
+        const FixedKeyVal& test = TEST_FIXED_POINT[ iNumber ];
+        for (bool bTrim : { false, true }) {
+            const char *pExpect = bTrim ? test.pTrimmed : test.pText;
+            char actual[ 32 ];
+            memset( actual, '#', sizeof(actual) );
+            status &= validate_write( actual, numdigits_write_fixed_point( actual, test.number, test.scale, bTrim ), pExpect );
+            status &= validate_write_length( numdigits_fixed_point( test.number, test.scale, bTrim ), pExpect );
+        }
+    }
+    printf( "%s %s\n", STATUS[status], "fixed point" );
+
+    const struct { const int64_t *aNumbers; int nNumbers; const char *pDescription; } aTables[] = {
+          { TEST_I64_MINMAX, NUM_I64_MINMAX, "min,0,max"    }
+        , { TEST_I64_NINES , NUM_I64_NINES , "nines"        }
+        , { TEST_I64_POW10 , NUM_I64_POW10 , "powers of 10" }
+        , { TEST_I64_POW2  , NUM_I64_POW2  , "powers of 2"  }
+    };
+
+    for (const auto& table : aTables) {
+        status = true;
+        for (int iNumber = 0; iNumber < table.nNumbers; iNumber++ )
+            for (uint32_t scale = 0; scale <= 18; scale++ )
+                for (bool bTrim : { false, true }) {
+                    const int64_t n = table.aNumbers[ iNumber ];
+                    char actual[ 48 ], expect[ 48 ];
+                    fixed_point_reference( expect, n, scale, bTrim );
+                    memset( actual, '#', sizeof(actual) );
+                    status &= validate_write( actual, numdigits_write_fixed_point( actual, n, scale, bTrim ), expect );
+                    status &= validate_write_length( numdigits_fixed_point( n, scale, bTrim ), expect );
+                }
+        printf( "%s %s, scale 0 .. 18\n", STATUS[status], table.pDescription );
+    }
+}
+
+// Reference: printf( "%.*g" ) with the smallest precision that reads back as the same value
+template <typename T>
+static int floating_reference( T v, char *pText, size_t nText )
+{
+    for (int precision = 1; ; precision++) {
+        const int len = snprintf( pText, nText, "%.*g", precision, (double)v );
+        const T   x   = (sizeof(T) == sizeof(float)) ? (T)strtof( pText, nullptr ) : (T)strtod( pText, nullptr );
+        if ((x == v) || (v != v))
+            return len;
+    }
+}
+
+// Specials, every power of 2, the powers of 10 and their neighbors, the int64_t tables and random bit patterns
+template <typename T, typename Bits>
+void test_floating( int (*pFunc)( T ) )
+{
+    const T INF  = std::numeric_limits<T>::infinity();
+    const T aSpecial[] = { (T)0, -(T)0, (T)1, -(T)1, (T)0.1, (T)1e-5, (T)123456, (T)1234567, INF, -INF, std::numeric_limits<T>::quiet_NaN()
+        , std::numeric_limits<T>::min(), std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest() };
+
+    std::vector<T> aPow2, aPow10, aIntegers, aRandom;
+    for (int e = std::numeric_limits<T>::min_exponent - std::numeric_limits<T>::digits; e < std::numeric_limits<T>::max_exponent; e++ )
+        aPow2.push_back( std::ldexp( (T)1, e ) );
+    for (int e = std::numeric_limits<T>::min_exponent10 - 1; e <= std::numeric_limits<T>::max_exponent10; e++ ) {
+        char text[ 16 ];
+        snprintf( text, sizeof(text), "1e%d", e );
+        const T pow10 = (sizeof(T) == sizeof(float)) ? (T)strtof( text, nullptr ) : (T)strtod( text, nullptr );
+        aPow10.push_back( std::nextafter( pow10, (T)0 ) );
+        aPow10.push_back( pow10 );
+        aPow10.push_back( std::nextafter( pow10, INF ) );
+    }
+    for (const auto& table : { std::make_pair( TEST_I64_NINES, NUM_I64_NINES ), std::make_pair( TEST_I64_POW10, NUM_I64_POW10 ), std::make_pair( TEST_I64_POW2, NUM_I64_POW2 ) })
+        for (int iNumber = 0; iNumber < table.second; iNumber++ )
+            aIntegers.push_back( (T)table.first[ iNumber ] );
+
+    uint64_t seed = 1;
+    while (aRandom.size() < 100000) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull; // LCG
+        const Bits bits = (Bits)(seed >> (64 - 8*sizeof(T)));
+        T x;
+        memcpy( &x, &bits, sizeof(x) );
+        if (std::isfinite( x ))
+            aRandom.push_back( x );
+    }
+
+    const struct { const T *aNumbers; int nNumbers; const char *pDescription; } aTables[] = {
+          { aSpecial        , (int)(sizeof(aSpecial) / sizeof(aSpecial[0])), "specials"             }
+        , { aPow2.data()    , (int)aPow2.size()                             , "powers of 2"          }
+        , { aPow10.data()   , (int)aPow10.size()                            , "powers of 10 +/- ulp" }
+        , { aIntegers.data(), (int)aIntegers.size()                         , "int64_t tables"       }
+        , { aRandom.data()  , (int)aRandom.size()                           , "100K random"          }
+    };
+
+    for (const auto& table : aTables) {
+        bool status = true;
+        for (int iNumber = 0; iNumber < table.nNumbers; iNumber++ ) {
+            const T v = table.aNumbers[ iNumber ];
+            char expect[ 48 ];
+            const int nExpect = floating_reference( v, expect, sizeof(expect) );
+            const int nActual = pFunc( v );
+            if (nActual != nExpect) {
+                status = false;
+                printf( "(%s) %2d != %2d %s test [%2d]\n", expect, nActual, nExpect, STATUS[status], iNumber );
+            }
+        }
+        printf( "%s %s\n", STATUS[status], table.pDescription );
+    }
+}
+
+// Every prefix of every table so the batch kernels' remainder paths are exercised too
+void test_serialize()
+{
+    const struct { const IntKeyVal *aNumbers; int nNumbers; const char *pDescription; } aTables[] = {
+          { TEST_INT_MINMAX, NUM_INT_MINMAX, "min,0,max"    }
+        , { TEST_INT_NINES , NUM_INT_NINES , "nines"        }
+        , { TEST_INT_POW2  , NUM_INT_POW2  , "powers of 2"  }
+        , { TEST_INT_POW10 , NUM_INT_POW10 , "powers of 10" }
+    };
+
+    for (const auto& table : aTables) {
+        bool status = true;
+
+        int32_t aInput[ 64 ];
+        assert( table.nNumbers <= 64 );
+        for (int iNumber = 0; iNumber < table.nNumbers; iNumber++ )
+            aInput[ iNumber ] = table.aNumbers[ iNumber ].number;
+
+        for (int nLen = 1; nLen <= table.nNumbers; nLen++ ) {
+            std::string expect;
+            for (int iNumber = 0; iNumber < nLen; iNumber++ ) {
+                char buffer[ 32 ];
+                sprintf( buffer, "%d,", aInput[ iNumber ] );
+                expect += buffer;
+            }
+
+            std::vector<char> actual;
+            const size_t      size = numdigits_serialize( aInput, nLen, ',', actual );
+            if ((size != expect.size()) || (actual.size() != size) || memcmp( actual.data(), expect.data(), size )) {
+                status = false;
+                printf( "'%.*s' != '%s' %s of %d\n", (int)actual.size(), actual.data(), expect.c_str(), STATUS[status], nLen );
+            }
+        }
+        printf( "%s %s\n", STATUS[status], table.pDescription );
+    }
+}
+
+// Each base is checked against the divide loop on the u64/i64 tables plus Base^k - 1, Base^k, Base^k + 1.
+// Base 8 and 16 are also checked against printf() "%o" and "%x" since that is the code they replace.
+void test_radix( uint32_t base, NumDigitsRadixU64FuncPtr pFuncU64, NumDigitsRadixI64FuncPtr pFuncI64 )
+{
+    std::vector<uint64_t> aPowers;
+    for (uint64_t pow = 1; ; pow *= base) {
+        aPowers.push_back( pow - 1 );
+        aPowers.push_back( pow     );
+        aPowers.push_back( pow + 1 );
+        if (pow > UINT64_MAX / base)
+            break;
+    }
+
+    const struct { const uint64_t *aNumbers; int nNumbers; const char *pDescription; } aTables[] = {
+          { TEST_U64_MINMAX, NUM_U64_MINMAX       , "min,0,max"       }
+        , { TEST_U64_NINES , NUM_U64_NINES        , "nines"           }
+        , { TEST_U64_POW2  , NUM_U64_POW2         , "powers of 2"     }
+        , { TEST_U64_POW10 , NUM_U64_POW10        , "powers of 10"    }
+        , { aPowers.data() , (int)aPowers.size()  , "powers of base"  }
+    };
+
+    for (const auto& table : aTables) {
+        bool status = true;
+        for (int iNumber = 0; iNumber < table.nNumbers; iNumber++ ) {
+            const uint64_t n      = table.aNumbers[ iNumber ];
+            const int      actual = pFuncU64( n );
+            const int      expect = (int) digits_radix_reference( n, base );
+            if (actual != expect) {
+                status = false;
+                printf( "(%20" PRIu64 ") %2d != %2d %s test [%2d]\n", n, actual, expect, STATUS[status], iNumber );
+            }
+
+            // Every |n| that fits is tested with both signs
+            for (int sign = 0; sign < 2; sign++ ) {
+                if (n > (uint64_t)INT64_MAX)
+                    break;
+                const int64_t i       = sign ? -(int64_t)n : (int64_t)n;
+                const int     actualI = pFuncI64( i );
+                const int     expectI = (i < 0) + expect;
+                if (actualI != expectI) {
+                    status = false;
+                    printf( "(%20" PRId64 ") %2d != %2d %s test [%2d]\n", i, actualI, expectI, STATUS[status], iNumber );
+                }
+            }
+
+            if ((base == 8) || (base == 16)) {
+                char buffer[ 32 ];
+                const int expectS = snprintf( buffer, sizeof(buffer), (base == 8) ? "%" PRIo64 : "%" PRIx64, n );
+                if (actual != expectS) {
+                    status = false;
+                    printf( "(%s) %2d != %2d %s printf test [%2d]\n", buffer, actual, expectS, STATUS[status], iNumber );
+                }
+            }
+        }
+        printf( "%s %s\n", STATUS[status], table.pDescription );
+    }
+}
+
+void add_stats_expect( NumDigitsStats& expect, uint32_t length )
+{
+    expect.Histogram[ length ]++;
+    expect.Total += length;
+    expect.Max    = std::max( expect.Max, length );
+}
+
+bool same_stats( const NumDigitsStats& actual, const NumDigitsStats& expect )
+{
+    bool same = (actual.Total == expect.Total) && (actual.Max == expect.Max);
+    for (int length = 0; length < 21; length++ )
+        same &= (actual.Histogram[ length ] == expect.Histogram[ length ]);
+    return same;
+}
+
+// Random numbers of every magnitude and both signs, with the extremes up front
+template <typename T>
+std::vector<T> make_stats_input( size_t nNumbers )
+{
+    std::vector<T> aInput( nNumbers );
+    uint64_t seed = 1;
+    for (size_t i = 0; i < nNumbers; i++ ) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull; // LCG
+        const T x = (T)(seed >> (64 - 8*sizeof(T)));
+        aInput[ i ] = x >> ((seed >> 8) % (8*sizeof(T)));
+    }
+    const T aExtremes[] = { std::numeric_limits<T>::min(), std::numeric_limits<T>::max(), 0, -1, 9, -10 };
+    for (size_t i = 0; i < std::min( nNumbers, sizeof(aExtremes) / sizeof(aExtremes[0]) ); i++ )
+        aInput[ i ] = aExtremes[ i ];
+    return aInput;
+}
+
+// Every length up to 300 for the SIMD remainder paths, then one long enough to flush the byte counters many times.
+// The result is added to stats so a non-empty starting value is checked too.
+template <typename T, typename FuncPtr, typename RefFunc>
+void test_reduce( FuncPtr pFunc, RefFunc refFunc )
+{
+    bool status = true;
+    std::vector<T> aInput = make_stats_input<T>( 300 );
+    for (size_t nLen = 0; nLen <= aInput.size(); nLen++ ) {
+        NumDigitsStats expect = {}, actual = {};
+        expect.Total = actual.Total = 7;
+        for (size_t i = 0; i < nLen; i++ )
+            add_stats_expect( expect, (uint32_t) refFunc( aInput[ i ] ) );
+        pFunc( aInput.data(), nLen, actual );
+        if (!same_stats( actual, expect )) {
+            status = false;
+            printf( "(%zu numbers) Total %" PRIu64 " != %" PRIu64 ", Max %u != %u %s\n", nLen, actual.Total, expect.Total, actual.Max, expect.Max, STATUS[status] );
+        }
+    }
+    printf( "%s %s\n", STATUS[status], "every length" );
+
+    aInput = make_stats_input<T>( 1000003 );
+    NumDigitsStats expect = {}, actual = {};
+    for (T n : aInput )
+        add_stats_expect( expect, (uint32_t) refFunc( n ) );
+    pFunc( aInput.data(), aInput.size(), actual );
+    status = same_stats( actual, expect );
+    if (!status)
+        printf( "Total %" PRIu64 " != %" PRIu64 ", Max %u != %u %s\n", actual.Total, expect.Total, actual.Max, expect.Max, STATUS[status] );
+    printf( "%s %s\n", STATUS[status], "1M random" );
+}
+
+// Sorted columns: runs of one length, duplicates, a single length and the full range, every prefix of the
+// boundaries, then unsorted input for the _if_sorted fallback. Stats start non-empty like test_reduce().
+void test_sorted()
+{
+    std::vector<std::vector<uint64_t>> aColumns;
+
+    std::vector<uint64_t> aBoundaries = { 0, 0, UINT64_MAX, UINT64_MAX };
+    for (int digits = 1; digits < 20; digits++)
+        for (uint64_t delta = 0; delta <= 2; delta++) {
+            aBoundaries.push_back( Pow10_constexpr[ digits ] - 1 - delta );
+            aBoundaries.push_back( Pow10_constexpr[ digits ]     + delta );
+        }
+    std::sort( aBoundaries.begin(), aBoundaries.end() );
+    for (size_t nLen = 0; nLen <= aBoundaries.size(); nLen++)
+        aColumns.push_back( std::vector<uint64_t>( aBoundaries.begin(), aBoundaries.begin() + nLen ) );
+    for (size_t iBegin = 1; iBegin < aBoundaries.size(); iBegin++)
+        aColumns.push_back( std::vector<uint64_t>( aBoundaries.begin() + iBegin, aBoundaries.end() ) );
+
+    aColumns.push_back( std::vector<uint64_t>( 1000, 123456 ) );
+
+    std::vector<uint64_t> aRandom( 1000003 );
+    uint64_t seed = 1;
+    for (uint64_t& n : aRandom) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull; // LCG
+        n = seed >> ((seed >> 8) % 64); // every magnitude
+    }
+    aColumns.push_back( aRandom );
+    std::sort( aRandom.begin(), aRandom.end() );
+    aColumns.push_back( aRandom );
+
+    std::vector<uint64_t> aIds( 1000003 );
+    for (size_t i = 0; i < aIds.size(); i++)
+        aIds[ i ] = 999'000 + i; // row ids crossing 10^6
+    aColumns.push_back( aIds );
+
+    bool statusBatch = true, statusReduce = true;
+    std::vector<uint8_t> aLengths, aExpect;
+    for (const std::vector<uint64_t>& aColumn : aColumns) {
+        const size_t nLen    = aColumn.size();
+        const bool   bSorted = std::is_sorted( aColumn.begin(), aColumn.end() );
+
+        NumDigitsStats expect = {};
+        expect.Total = 7;
+        aExpect.assign( nLen, 0 );
+        for (size_t i = 0; i < nLen; i++) {
+            aExpect[ i ] = (uint8_t) numdigits10_uint64( aColumn[ i ] );
+            add_stats_expect( expect, aExpect[ i ] );
+        }
+
+        for (int iFunc = bSorted ? 0 : 1; iFunc < 2; iFunc++) {
+            const char *pName = iFunc ? "if_sorted" : "sorted";
+
+            aLengths.assign( nLen + 1, 0xFF ); // the byte past the end must not be written
+            if (iFunc) digits10_batch_u64_if_sorted( aColumn.data(), nLen, aLengths.data() );
+            else       digits10_batch_u64_sorted   ( aColumn.data(), nLen, aLengths.data() );
+            if (!std::equal( aExpect.begin(), aExpect.end(), aLengths.begin() ) || (aLengths[ nLen ] != 0xFF)) {
+                statusBatch = false;
+                printf( "(%zu numbers) batch_u64_%s lengths %s\n", nLen, pName, STATUS[statusBatch] );
+            }
+
+            NumDigitsStats actual = {};
+            actual.Total = 7;
+            if (iFunc) digits10_reduce_u64_if_sorted( aColumn.data(), nLen, actual );
+            else       digits10_reduce_u64_sorted   ( aColumn.data(), nLen, actual );
+            if (!same_stats( actual, expect )) {
+                statusReduce = false;
+                printf( "(%zu numbers) reduce_u64_%s Total %" PRIu64 " != %" PRIu64 ", Max %u != %u %s\n", nLen, pName, actual.Total, expect.Total, actual.Max, expect.Max, STATUS[statusReduce] );
+            }
+        }
+    }
+    printf( "%s %s\n", STATUS[statusBatch ], "batch_u64_sorted, batch_u64_if_sorted" );
+    printf( "%s %s\n", STATUS[statusReduce], "reduce_u64_sorted, reduce_u64_if_sorted" );
+}
+
+// Several thread counts over an array that isn't a multiple of the chunk size, against the scalar lengths
+void test_parallel_stats()
+{
+    const size_t N = 5 * NUMDIGITS_PARALLEL_CHUNK + 12345;
+
+    std::vector<int32_t> aInput( N );
+    uint32_t seed = 1;
+    for (size_t i = 0; i < N; i++ ) {
+        seed = seed * 1664525u + 1013904223u; // LCG
+        aInput[ i ] = (int32_t)seed >> (seed & 31); // every magnitude, both signs
+    }
+    aInput[ 0 ] = INT_MIN;
+    aInput[ 1 ] = INT_MAX;
+    aInput[ 2 ] = 0;
+
+    NumDigitsStats expect = {};
+    for (int32_t n : aInput )
+        add_stats_expect( expect, (uint32_t) numdigits10_int32( n ) );
+
+    for (unsigned nThreads : { 1u, 2u, 3u, 8u, 0u }) {
+        const NumDigitsStats actual = numdigits_parallel_stats( aInput.data(), N, nThreads );
+        const bool status = same_stats( actual, expect );
+        if (!status)
+            printf( "(%u threads) Total %" PRIu64 " != %" PRIu64 " %s\n", nThreads, actual.Total, expect.Total, STATUS[status] );
+        printf( "%s %u threads\n", STATUS[status], nThreads );
+    }
+
+    const NumDigitsStats empty = numdigits_parallel_stats( aInput.data(), 0 );
+    printf( "%s empty\n", STATUS[ empty.Total == 0 ] );
+}
+
+// Both lanes against numdigits10_uint32(): every boundary in each lane next to every boundary
+// in the other lane, since a carry or borrow across lanes would only show up at the edges
+void test_swar_u32x2()
+{
+    std::vector<uint32_t> aNumbers = { 0, 1, UINT32_MAX };
+    for (int digits = 1; digits < 10; digits++)
+        for (uint32_t delta = 0; delta <= 2; delta++) {
+            aNumbers.push_back( (uint32_t)Pow10_constexpr[ digits ] - 1 - delta );
+            aNumbers.push_back( (uint32_t)Pow10_constexpr[ digits ]     + delta );
+        }
+    for (int bits = 28; bits < 32; bits++) {
+        aNumbers.push_back( (1u << bits) - 1 );
+        aNumbers.push_back( (1u << bits)     );
+    }
+
+    bool status = true;
+    for (uint32_t a : aNumbers)
+        for (uint32_t b : aNumbers) {
+            const uint64_t digits = digits10_swar_u32x2( digits10_swar_pack( a, b ) );
+            if ((uint32_t)digits != numdigits10_uint32( a ) || (uint32_t)(digits >> 32) != numdigits10_uint32( b )) {
+                status = false;
+                printf( "(%10u, %10u) %2u, %2u != %2u, %2u %s\n", a, b, (uint32_t)digits, (uint32_t)(digits >> 32), numdigits10_uint32( a ), numdigits10_uint32( b ), STATUS[status] );
+            }
+        }
+    printf( "%s %s\n", STATUS[status], "boundary pairs" );
+
+    status = true;
+    uint64_t seed = 1;
+    for (int i = 0; i < 1'000'000; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull; // LCG
+        const uint32_t a = (uint32_t)(seed >> 32) >> (seed & 31);        // every magnitude
+        const uint32_t b = (uint32_t) seed        >> ((seed >> 5) & 31);
+        const uint64_t digits = digits10_swar_u32x2( digits10_swar_pack( a, b ) );
+        if ((uint32_t)digits != numdigits10_uint32( a ) || (uint32_t)(digits >> 32) != numdigits10_uint32( b )) {
+            status = false;
+            printf( "(%10u, %10u) %2u, %2u != %2u, %2u %s\n", a, b, (uint32_t)digits, (uint32_t)(digits >> 32), numdigits10_uint32( a ), numdigits10_uint32( b ), STATUS[status] );
+            break;
+        }
+    }
+    printf( "%s %s\n", STATUS[status], "random pairs" );
+}
+
+void test_batch( NumDigitsBatchFuncPtr pFunc )
+{
+    validate_table_batch( TEST_INT_MINMAX, NUM_INT_MINMAX, "min,0,max"   , pFunc );
+    validate_table_batch( TEST_INT_NINES , NUM_INT_NINES , "nines"       , pFunc );
+    validate_table_batch( TEST_INT_POW2  , NUM_INT_POW2  , "powers of 2" , pFunc );
+    validate_table_batch( TEST_INT_POW10 , NUM_INT_POW10 , "powers of 10", pFunc );
+}
+
+void test_batch_i64( NumDigitsBatchI64FuncPtr pFunc )
+{
+    validate_table_batch_i64( TEST_I64_MINMAX, NUM_I64_MINMAX, "min,0,max"   , pFunc );
+    validate_table_batch_i64( TEST_I64_NINES , NUM_I64_NINES , "nines"       , pFunc );
+    validate_table_batch_i64( TEST_I64_POW10 , NUM_I64_POW10 , "powers of 10", pFunc );
+    validate_table_batch_i64( TEST_I64_POW2  , NUM_I64_POW2  , "powers of 2" , pFunc );
+}
+
+void test_batch_u64( NumDigitsBatchU64FuncPtr pFunc )
+{
+    validate_table_batch_u64( TEST_U64_MINMAX, NUM_U64_MINMAX, "min,0,max"   , pFunc );
+    validate_table_batch_u64( TEST_U64_NINES , NUM_U64_NINES , "nines"       , pFunc );
+    validate_table_batch_u64( TEST_U64_POW2  , NUM_U64_POW2  , "powers of 2" , pFunc );
+    validate_table_batch_u64( TEST_U64_POW10 , NUM_U64_POW10 , "powers of 10", pFunc );
+}
+
+// ========================================
+void validate_table_int( const IntKeyVal *aNumbers, int nNumbers, const char *pDescription, NumDigitsIntFuncPtr pFunc )
+{
+    bool status = true;
+
+    // We have a few choices to use as our reference version to compare against:
+    //   numdigits_dumb_int64( (int64_t)n );
+    //   numdigits_dumb_sprintf_strlen
+    //   numdigits_if_naive
+    //   numdigits10_i32
+    // But couldn't/shouldn't trust any of those
+    // so we embed the expected answer along with the test number.
+    for (int iNumber = 0; iNumber < nNumbers; iNumber++ ) {
+        int      n = aNumbers[ iNumber ].number;
+        int actual = pFunc( n );
+        int expect = aNumbers[ iNumber ].expect;
+        if (actual != expect) {
+            status = false;
+            printf( "(%11d) Actual %2d != Expect %2d %s test [%2d]\n", n, actual, expect, STATUS[status], iNumber );
+        }
+    }
+    printf( "%s %s\n", STATUS[status], pDescription );
+}
+
+void validate_table_i64(const int64_t* aNumbers, int nNumbers, const char* pDescription, NumDigitsI64FuncPtr pFunc)
+{
+    bool status = true;
+
+    for (int iNumber = 0; iNumber < nNumbers; iNumber++ ) {
+        int64_t   n = aNumbers[ iNumber ];
+        int32_t actual = pFunc            ( n );
+        int32_t expect = numdigits10_int64( n );
+        if (actual != expect) {
+            status = false;
+            printf( "(%11" PRId64 ") %2d != %2d %s test [%2d]\n", n, actual, expect, STATUS[status], iNumber );
+        }
+    }
+    printf( "%s %s\n", STATUS[status], pDescription );
+}
+
+void validate_table_u64( const uint64_t* aNumbers, int nNumbers, const char* pDescription, NumDigitsU64FuncPtr pFunc )
+{
+    bool status = true;
+
+    for (int iNumber = 0; iNumber < nNumbers; iNumber++ ) {
+        uint64_t   n = aNumbers[ iNumber ];
+        int32_t actual = pFunc            (  n );
+        int32_t expect = numdigits10_uint64( n );
+        if (actual != expect) {
+            status = false;
+            printf( "(%20" PRIu64 ") %2d != %2d %s test [%2d]\n", n, actual, expect, STATUS[status], iNumber );
+        }
+    }
+    printf( "%s %s\n", STATUS[status], pDescription );
+}
+
+#if NUMDIGITS_INT128
+void validate_table_u128( const U128KeyVal *aNumbers, int nNumbers, const char *pDescription, NumDigitsU128FuncPtr pFunc )
+{
+    bool status = true;
+
+    for (int iNumber = 0; iNumber < nNumbers; iNumber++ ) {
+        unsigned __int128 n = ((unsigned __int128)aNumbers[ iNumber ].hi << 64) | aNumbers[ iNumber ].lo;
+        int32_t      actual = pFunc( n );
+        int32_t      expect = aNumbers[ iNumber ].expect;
+        if (actual != expect) {
+            status = false;
+            printf( "(0x%016" PRIX64 "%016" PRIX64 ") %2d != %2d %s test [%2d]\n", aNumbers[ iNumber ].hi, aNumbers[ iNumber ].lo, actual, expect, STATUS[status], iNumber );
+        }
+    }
+    printf( "%s %s\n", STATUS[status], pDescription );
+}
+
+// With bBothSigns the table is unsigned and every number that fits is also tested negated
+void validate_table_i128( const U128KeyVal *aNumbers, int nNumbers, const char *pDescription, NumDigitsI128FuncPtr pFunc, bool bBothSigns )
+{
+    bool status = true;
+
+    for (int iNumber = 0; iNumber < nNumbers; iNumber++ ) {
+        const unsigned __int128 x = ((unsigned __int128)aNumbers[ iNumber ].hi << 64) | aNumbers[ iNumber ].lo;
+        if (bBothSigns && (aNumbers[ iNumber ].hi >> 63))
+            continue; // doesn't fit in __int128
+
+        for (int iSign = 0; iSign < 1 + bBothSigns; iSign++ ) {
+            __int128 n      = iSign ? -(__int128)x : (__int128)x;
+            int32_t  actual = pFunc( n );
+            int32_t  expect = aNumbers[ iNumber ].expect + (iSign && x);
+            if (actual != expect) {
+                status = false;
+                printf( "(%c0x%016" PRIX64 "%016" PRIX64 ") %2d != %2d %s test [%2d]\n", iSign ? '-' : '+', aNumbers[ iNumber ].hi, aNumbers[ iNumber ].lo, actual, expect, STATUS[status], iNumber );
+            }
+        }
+    }
+    printf( "%s %s\n", STATUS[status], pDescription );
+}
+#endif
+
+bool validate_bigint( const std::vector<uint64_t>& aLimbs, NumDigitsBigIntFuncPtr pFunc )
+{
+    const size_t actual = pFunc             ( aLimbs.data(), aLimbs.size() );
+    const size_t expect = numdigits10_bigint( aLimbs.data(), aLimbs.size() );
+    if (actual != expect) {
+        printf( "(%zu limbs, top 0x%016" PRIX64 ") %zu != %zu %s\n", aLimbs.size(), aLimbs.empty() ? 0 : aLimbs.back(), actual, expect, STATUS[0] );
+        return false;
+    }
+    return true;
+}
+
+bool validate_write( const char *pActual, int nActual, const char *pExpect )
+{
+    const int nExpect = (int) strlen( pExpect );
+    if ((nActual != nExpect) || memcmp( pActual, pExpect, nExpect ) || (pActual[ nActual ] != '#')) {
+        printf( "(%s) '%.*s' %2d != %2d %s\n", pExpect, std::max( 0, std::min( nActual, 31 ) ), pActual, nActual, nExpect, STATUS[0] );
+        return false;
+    }
+    return true;
+}
+
+// The SIMD kernels only process full vectors and leave the remainder to the scalar version
+// so we test every length to exercise both paths.
+void validate_table_batch( const IntKeyVal *aNumbers, int nNumbers, const char *pDescription, NumDigitsBatchFuncPtr pFunc )
+{
+    bool status = true;
+
+    int32_t aInput  [ 64 ];
+    uint8_t aLengths[ 64 ];
+    assert( nNumbers <= 64 );
+
+    for (int iNumber = 0; iNumber < nNumbers; iNumber++ )
+        aInput[ iNumber ] = aNumbers[ iNumber ].number;
+
+    for (int nLen = 1; nLen <= nNumbers; nLen++ ) {
+        memset( aLengths, 0, sizeof(aLengths) );
+        pFunc( aInput, nLen, aLengths );
+        for (int iNumber = 0; iNumber < nLen; iNumber++ ) {
+            int      n = aNumbers[ iNumber ].number;
+            int actual = aLengths[ iNumber ];
+            int expect = aNumbers[ iNumber ].expect;
+            if (actual != expect) {
+                status = false;
+                printf( "(%11d) Actual %2d != Expect %2d %s test [%2d] of %d\n", n, actual, expect, STATUS[status], iNumber, nLen );
+            }
+        }
+    }
+    printf( "%s %s\n", STATUS[status], pDescription );
+}
+
+void validate_table_batch_i64( const int64_t *aNumbers, int nNumbers, const char *pDescription, NumDigitsBatchI64FuncPtr pFunc )
+{
+    bool status = true;
+
+    uint8_t aLengths[ 128 ];
+    assert( nNumbers <= 128 );
+
+    for (int nLen = 1; nLen <= nNumbers; nLen++ ) {
+        memset( aLengths, 0, sizeof(aLengths) );
+        pFunc( aNumbers, nLen, aLengths );
+        for (int iNumber = 0; iNumber < nLen; iNumber++ ) {
+            int64_t   n = aNumbers[ iNumber ];
+            int32_t actual = aLengths[ iNumber ];
+            int32_t expect = numdigits10_int64( n );
+            if (actual != expect) {
+                status = false;
+                printf( "(%11" PRId64 ") %2d != %2d %s test [%2d] of %d\n", n, actual, expect, STATUS[status], iNumber, nLen );
+            }
+        }
+    }
+    printf( "%s %s\n", STATUS[status], pDescription );
+}
+
+void validate_table_batch_u64( const uint64_t *aNumbers, int nNumbers, const char *pDescription, NumDigitsBatchU64FuncPtr pFunc )
+{
+    bool status = true;
+
+    uint8_t aLengths[ 128 ];
+    assert( nNumbers <= 128 );
+
+    for (int nLen = 1; nLen <= nNumbers; nLen++ ) {
+        memset( aLengths, 0, sizeof(aLengths) );
+        pFunc( aNumbers, nLen, aLengths );
+        for (int iNumber = 0; iNumber < nLen; iNumber++ ) {
+            uint64_t   n = aNumbers[ iNumber ];
+            int32_t actual = aLengths[ iNumber ];
+            int32_t expect = numdigits10_uint64( n );
+            if (actual != expect) {
+                status = false;
+                printf( "(%20" PRIu64 ") %2d != %2d %s test [%2d] of %d\n", n, actual, expect, STATUS[status], iNumber, nLen );
+            }
+        }
+    }
+    printf( "%s %s\n", STATUS[status], pDescription );
+}
+
+// ========================================
+void verify_int()
+{
+    const char *CATEGORY = "int";
+
+    struct FuncDescInt
+    {
+        NumDigitsIntFuncPtr pFunc;
+        const char         *pName;
+    };
+
+    FuncDescInt aFuncs[] = {
+          { numdigits_adaptive                 , "adaptive"                  }
+        , { numdigits_alexandrescu_v1          , "alexandrescu_v1"           }
+        , { numdigits_alexandrescu_pohoreski_v2, "alexandrescu_pohoreski_v2" }
+        , { numdigits_alexandrescu_pohoreski_v3, "alexandrescu_pohoreski_v3" }
+        , { numdigits_alink_buggy_v1           , "alink_buggy_v1"            }
+        , { numdigits_alink_buggy_v2           , "alink_buggy_v2"            }
+        , { numdigits_alink_fixed_v1a          , "alink_fixed_v1a"           }
+        , { numdigits_alink_fixed_v1b          , "alink_fixed_v1b"           }
+        , { numdigits_alink_fixed_v2a          , "alink_fixed_v2a"           }
+        , { numdigits_alink_fixed_v2b          , "alink_fixed_v2b"           }
+        , { numdigits_best_int                 , "best_int"                  }
+        , { numdigits_clifford_buggy           , "clifford_buggy"            }
+        , { numdigits_clifford_fixed           , "clifford_fixed"            }
+        , { numdigits_dagostino_pohoreski      , "dagostino_pohoreski"       }
+        , { numdigits_dumb_sprintf_strlen      , "dumb_sprintf_strlen"       }
+        , { numdigits_gabriel_v1a              , "gabriel_v1a"               }
+        , { numdigits_gabriel_v1b              , "gabriel_v1b"               }
+        , { numdigits_gabriel_v1c              , "gabriel_v1c"               }
+        , { numdigits_if_naive                 , "if_naive"                  }
+        , { numdigits_count                    , "count"                     }
+        , { numdigits_fpexp                    , "fpexp"                     }
+        , { numdigits_log                      , "log"                       }
+        , { numdigits_lut32                    , "lut32"                     }
+        , { numdigits_lzcnt                    , "lzcnt"                     }
+        , { numdigits_microsoft_itoa_strlen    , "microsoft_itoa_strlen"     }
+        , { numdigits_pohoreski_v1a            , "pohoreski_v1a"             }
+        , { numdigits_pohoreski_v1b            , "pohoreski_v1b"             }
+        , { numdigits_pohoreski_v2a            , "pohoreski_v2a"             }
+        , { numdigits_pohoreski_v2b            , "pohoreski_v2b"             }
+        , { numdigits_pohoreski_v3a            , "pohoreski_v3a"             }
+        , { numdigits_pohoreski_v3b            , "pohoreski_v3b"             }
+        , { numdigits_pohoreski_v4a            , "pohoreski_v4a"             }
+        , { numdigits_pohoreski_v4b            , "pohoreski_v4b"             }
+        , { numdigits_ransom                   , "ransom"                    }
+        , { numdigits10_int32                  , "reference_int32"           }
+        , { numdigits10_int                    , "reference_pow10_int"       }
+        , { numdigits10_mixed_int              , "reference_mixed_int"       }
+        , { numdigits_simple                   , "simple"                    }
+        , { numdigits_simple_reverse           , "simple_reverse"            }
+        , { numdigits_simple_reverse32         , "simple_reverse32"          }
+        , { numdigits<int>                     , "template"                  }
+        , { numdigits_thomas                   , "thomas"                    }
+        , { numdigits_tree_small32             , "tree_small32"              }
+        , { numdigits_tree_uniform32           , "tree_uniform32"            }
+        , { numdigits_user42690_buggy          , "user42690_buggy"           }
+        , { numdigits_user42690_fixed_a        , "user42690_fixed_a"         }
+        , { numdigits_user42690_fixed_b        , "user42690_fixed_b"         }
+        , { numdigits_vitali                   , "vitali"                    }
+    };
+    const int nFuncs = sizeof(aFuncs) / sizeof(aFuncs[0]);
+
+    // Every digits10_*() core with every sign fold, named fold_<core>_<fold>
+    std::vector<NumDigitsFoldDesc> aFolds = numdigits_fold_products();
+    for (NumDigitsFoldDesc& fold : aFolds)
+        fold.Name = "fold_" + fold.Name;
+
+    if (g_bCategoryPrint) {
+        printf( "Available tests for '-%s' (%d):\n", CATEGORY, nFuncs + (int)aFolds.size() + 3 );
+        for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
+            const char *pNextTestName = aFuncs[ iFunc ].pName;
+            printf( "    %s\n", pNextTestName );
+        }
+        for (const NumDigitsFoldDesc& fold : aFolds)
+            printf( "    %s\n", fold.Name.c_str() );
+        printf( "    %s\n", "adaptive_shift" );
+        printf( "    %s\n", "lut16" );
+        printf( "    %s\n", "lut32_halves" );
+    }
+
+    printf( "----------------------------------------\n\n" );
+    for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
+        const char *pNextTestName = aFuncs[ iFunc ].pName;
+        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
+        if (bRunTest) {
+            printf( "\n========== %s (%s) ==========\n", pNextTestName, CATEGORY );
+            test_int( aFuncs[ iFunc ].pFunc );
+        }
+    }
+    for (const NumDigitsFoldDesc& fold : aFolds) {
+        const char *pNextTestName = fold.Name.c_str();
+        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
+        if (bRunTest) {
+            printf( "\n========== %s (%s) ==========\n", pNextTestName, CATEGORY );
+            test_int( fold.pFunc );
+        }
+    }
+    if (isTestIncluded( g_pCategoryInclude, "adaptive_shift" )) {
+        printf( "\n========== %s (%s) ==========\n", "adaptive_shift", CATEGORY );
+        test_adaptive_shift();
+    }
+    if (isTestIncluded( g_pCategoryInclude, "lut16" )) {
+        printf( "\n========== %s (%s) ==========\n", "lut16", CATEGORY );
+        test_lut16();
+    }
+    if (isTestIncluded( g_pCategoryInclude, "lut32_halves" )) {
+        printf( "\n========== %s (%s) ==========\n", "lut32_halves", CATEGORY );
+        test_lut32_halves();
+    }
+    printf( "\n" );
+}
+
+void verify_i64()
+{
+    const char *CATEGORY = "i64";
+    struct FuncDescI64
+    {
+        NumDigitsI64FuncPtr pFunc;
+        const char         *pName;
+    };
+
+    FuncDescI64 aFuncs[] = {
+          { numdigits10_int64                 , "numdigits10_int64"    }
+        , { numdigits_dumb_int64              , "numdigits_dumb_int64" }
+        , { numdigits_fpexp_int64             , "fpexp_int64"          }
+        , { numdigits_lzcnt_int64             , "lzcnt_int64"          }
+        , { numdigits_simple_int64            , "simple_int64"         }
+        , { numdigits<int64_t>                , "template_int64"       }
+        , { numdigits_vitali_template<int64_t>, "vitali_int64"         }
+    };
+    const int nFuncs = sizeof(aFuncs) / sizeof(aFuncs[0]);
+
+    if (g_bCategoryPrint) {
+        printf( "Available tests for '-%s' (%d):\n", CATEGORY, nFuncs );
+        for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
+            const char *pNextTestName = aFuncs[ iFunc ].pName;
+            printf( "    %s\n", pNextTestName );
+        }
+    }
+
+    printf( "----------------------------------------\n\n" );
+    for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
+        const char *pNextTestName = aFuncs[ iFunc ].pName;
+        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
+        if (bRunTest) {
+            printf( "\n========== %s (%s) ==========\n", aFuncs[ iFunc ].pName, CATEGORY );
+            test_i64( aFuncs[ iFunc ].pFunc );
+        }
+    }
+    printf( "\n" );
+}
+
+void verify_u64()
+{
+    const char *CATEGORY = "u64";
+    struct FuncDescU64
+    {
+        NumDigitsU64FuncPtr pFunc;
+        const char         *pName;
+    };
+
+    FuncDescU64 aFuncs[] = {
+          { numdigits10_uint64        , "numdigits10_uint64"         }
+        , { numdigits10_reverse_uint64, "numdigits10_reverse_uint64" }
         , { digits10_alexandrescu_v2  , "digits10_alexandrescu_v2"   }
         , { digits10_alexandrescu_v3  , "digits10_alexandrescu_v3"   }
+        , { digits10_constexpr        , "digits10_constexpr"         }
         , { digits10_dagostino        , "digits10_dagostino"         }
+        , { digits10_fpexp            , "digits10_fpexp"             }
+        , { numdigits_best_u64        , "best_u64"                   }
         , { digits10_gabriel          , "digits10_gabriel"           }
+        , { digits10_lzcnt            , "digits10_lzcnt"             }
         , { digits10_pohoreski_v1     , "digits10_pohoreski_v1"      }
         , { digits10_pohoreski_v2     , "digits10_pohoreski_v2"      }
+        , { digits10_tree_small64     , "digits10_tree_small64"      }
     };
     const int nFuncs = sizeof(aFuncs) / sizeof(aFuncs[0]);
 
-    if (g_bCategoryPrint)
-        printf( "Available tests for '-%s' (%d):\n", CATEGORY, nFuncs );
+    if (g_bCategoryPrint) {
+        printf( "Available tests for '-%s' (%d):\n", CATEGORY, nFuncs + 3 );
         for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
             const char *pNextTestName = aFuncs[ iFunc ].pName;
             printf( "    %s\n", pNextTestName );
         }
+        printf( "    %s\n", "exit_profile" );
+        printf( "    %s\n", "magnitude" );
+        printf( "    %s\n", "fpexp_rounding" );
+    }
 
     printf( "----------------------------------------\n\n" );
     for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
@@ -873,6 +2385,422 @@ void verify_u64()
             test_u64( aFuncs[ iFunc ].pFunc );
         }
     }
+    if (isTestIncluded( g_pCategoryInclude, "exit_profile" )) {
+        printf( "\n========== %s (%s) ==========\n", "exit_profile", CATEGORY );
+        test_exit_profile();
+    }
+    if (isTestIncluded( g_pCategoryInclude, "magnitude" )) {
+        printf( "\n========== %s (%s) ==========\n", "magnitude", CATEGORY );
+        test_magnitude();
+    }
+    if (isTestIncluded( g_pCategoryInclude, "fpexp_rounding" )) {
+        printf( "\n========== %s (%s) ==========\n", "fpexp_rounding", CATEGORY );
+        test_fpexp_rounding();
+    }
+    printf( "\n" );
+}
+
+void verify_128()
+{
+#if NUMDIGITS_INT128
+    const char *CATEGORY = "128";
+    struct FuncDescU128
+    {
+        NumDigitsU128FuncPtr pFunc;
+        const char          *pName;
+    };
+
+    FuncDescU128 aFuncsU128[] = {
+          { numdigits10_uint128, "numdigits10_uint128" }
+        , { digits10_u128      , "digits10_u128"       }
+    };
+    const int nFuncsU128 = sizeof(aFuncsU128) / sizeof(aFuncsU128[0]);
+
+    struct FuncDescI128
+    {
+        NumDigitsI128FuncPtr pFunc;
+        const char          *pName;
+    };
+
+    FuncDescI128 aFuncsI128[] = {
+          { numdigits10_int128 , "numdigits10_int128"  }
+        , { numdigits_i128     , "numdigits_i128"      }
+    };
+    const int nFuncsI128 = sizeof(aFuncsI128) / sizeof(aFuncsI128[0]);
+
+    if (g_bCategoryPrint) {
+        printf( "Available tests for '-%s' (%d):\n", CATEGORY, nFuncsU128 + nFuncsI128 );
+        for (int iFunc = 0; iFunc < nFuncsU128; iFunc++) {
+            const char *pNextTestName = aFuncsU128[ iFunc ].pName;
+            printf( "    %s\n", pNextTestName );
+        }
+        for (int iFunc = 0; iFunc < nFuncsI128; iFunc++) {
+            const char *pNextTestName = aFuncsI128[ iFunc ].pName;
+            printf( "    %s\n", pNextTestName );
+        }
+    }
+
+    printf( "----------------------------------------\n\n" );
+    for (int iFunc = 0; iFunc < nFuncsU128; iFunc++) {
+        const char *pNextTestName = aFuncsU128[ iFunc ].pName;
+        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
+        if (bRunTest) {
+            printf( "\n========== %s (%s) ==========\n", pNextTestName, CATEGORY );
+            test_u128( aFuncsU128[ iFunc ].pFunc );
+        }
+    }
+    for (int iFunc = 0; iFunc < nFuncsI128; iFunc++) {
+        const char *pNextTestName = aFuncsI128[ iFunc ].pName;
+        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
+        if (bRunTest) {
+            printf( "\n========== %s (%s) ==========\n", pNextTestName, CATEGORY );
+            test_i128( aFuncsI128[ iFunc ].pFunc );
+        }
+    }
+    printf( "\n" );
+#else
+    printf( "SKIP no __int128\n" );
+#endif
+}
+
+void verify_bigint()
+{
+    const char *CATEGORY = "big";
+    struct FuncDescBigInt
+    {
+        NumDigitsBigIntFuncPtr pFunc;
+        const char            *pName;
+    };
+
+    FuncDescBigInt aFuncs[] = {
+          { digits10_bigint, "digits10_bigint" }
+    };
+    const int nFuncs = sizeof(aFuncs) / sizeof(aFuncs[0]);
+
+    if (g_bCategoryPrint) {
+        printf( "Available tests for '-%s' (%d):\n", CATEGORY, nFuncs );
+        for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
+            const char *pNextTestName = aFuncs[ iFunc ].pName;
+            printf( "    %s\n", pNextTestName );
+        }
+    }
+
+    printf( "----------------------------------------\n\n" );
+    for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
+        const char *pNextTestName = aFuncs[ iFunc ].pName;
+        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
+        if (bRunTest) {
+            printf( "\n========== %s (%s) ==========\n", pNextTestName, CATEGORY );
+            test_bigint( aFuncs[ iFunc ].pFunc );
+        }
+    }
+    printf( "\n" );
+}
+
+void verify_write()
+{
+    const char *CATEGORY = "write";
+
+    // Each writer has its own signature so the entry runs its test
+    struct FuncDescWrite
+    {
+        void      (*pTest)();
+        const char *pName;
+    };
+
+    FuncDescWrite aFuncs[] = {
+          { []{ test_write<int     >( numdigits_write       ); }, "write_int"   }
+        , { []{ test_write<int64_t >( numdigits_write_int64 ); }, "write_int64" }
+        , { []{ test_write<uint64_t>( digits10_write        ); }, "write_u64"   }
+        , { []{ test_write_grouped();                     }, "write_grouped" }
+        , { []{ test_write_fixed_point();                 }, "write_fixed_point" }
+        , { []{ test_serialize();                         }, "serialize"   }
+    };
+    const int nFuncs = sizeof(aFuncs) / sizeof(aFuncs[0]);
+
+    if (g_bCategoryPrint) {
+        printf( "Available tests for '-%s' (%d):\n", CATEGORY, nFuncs );
+        for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
+            const char *pNextTestName = aFuncs[ iFunc ].pName;
+            printf( "    %s\n", pNextTestName );
+        }
+    }
+
+    printf( "----------------------------------------\n\n" );
+    for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
+        const char *pNextTestName = aFuncs[ iFunc ].pName;
+        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
+        if (bRunTest) {
+            printf( "\n========== %s (%s) ==========\n", pNextTestName, CATEGORY );
+            aFuncs[ iFunc ].pTest();
+        }
+    }
+    printf( "\n" );
+}
+
+void verify_radix()
+{
+    const char *CATEGORY = "radix";
+    struct FuncDescRadix
+    {
+        uint32_t                 nBase;
+        NumDigitsRadixU64FuncPtr pFuncU64;
+        NumDigitsRadixI64FuncPtr pFuncI64;
+        const char              *pName;
+    };
+
+    FuncDescRadix aFuncs[] = {
+          {  2, numdigits< 2, uint64_t>, numdigits< 2, int64_t>, "radix_2"  }
+        , {  3, numdigits< 3, uint64_t>, numdigits< 3, int64_t>, "radix_3"  }
+        , {  7, numdigits< 7, uint64_t>, numdigits< 7, int64_t>, "radix_7"  }
+        , {  8, numdigits< 8, uint64_t>, numdigits< 8, int64_t>, "radix_8"  }
+        , { 10, numdigits<10, uint64_t>, numdigits<10, int64_t>, "radix_10" }
+        , { 16, numdigits<16, uint64_t>, numdigits<16, int64_t>, "radix_16" }
+        , { 32, numdigits<32, uint64_t>, numdigits<32, int64_t>, "radix_32" }
+        , { 36, numdigits<36, uint64_t>, numdigits<36, int64_t>, "radix_36" }
+    };
+    const int nFuncs = sizeof(aFuncs) / sizeof(aFuncs[0]);
+
+    if (g_bCategoryPrint) {
+        printf( "Available tests for '-%s' (%d):\n", CATEGORY, nFuncs );
+        for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
+            const char *pNextTestName = aFuncs[ iFunc ].pName;
+            printf( "    %s\n", pNextTestName );
+        }
+    }
+
+    printf( "----------------------------------------\n\n" );
+    for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
+        const char *pNextTestName = aFuncs[ iFunc ].pName;
+        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
+        if (bRunTest) {
+            printf( "\n========== %s (%s) ==========\n", pNextTestName, CATEGORY );
+            test_radix( aFuncs[ iFunc ].nBase, aFuncs[ iFunc ].pFuncU64, aFuncs[ iFunc ].pFuncI64 );
+        }
+    }
+    printf( "\n" );
+}
+
+void verify_float()
+{
+    const char *CATEGORY = "float";
+
+    struct FuncDescFloat
+    {
+        void      (*pTest)();
+        const char *pName;
+    };
+
+    FuncDescFloat aFuncs[] = {
+          { []{ test_floating<double, uint64_t>( numdigits_double ); }, "double" }
+        , { []{ test_floating<float , uint32_t>( numdigits_float  ); }, "float"  }
+    };
+    const int nFuncs = sizeof(aFuncs) / sizeof(aFuncs[0]);
+
+    if (g_bCategoryPrint) {
+        printf( "Available tests for '-%s' (%d):\n", CATEGORY, nFuncs );
+        for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
+            const char *pNextTestName = aFuncs[ iFunc ].pName;
+            printf( "    %s\n", pNextTestName );
+        }
+    }
+
+    printf( "----------------------------------------\n\n" );
+    for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
+        const char *pNextTestName = aFuncs[ iFunc ].pName;
+        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
+        if (bRunTest) {
+            printf( "\n========== %s (%s) ==========\n", pNextTestName, CATEGORY );
+            aFuncs[ iFunc ].pTest();
+        }
+    }
+    printf( "\n" );
+}
+
+void verify_batch()
+{
+    const char *CATEGORY = "batch";
+    struct FuncDescBatch
+    {
+        NumDigitsBatchFuncPtr pFunc;
+        const char           *pName;
+        int                   nCPU; // NumDigitsCPU_e required to run
+    };
+
+    FuncDescBatch aFuncs[] = {
+          { numdigits_batch_scalar, "batch_scalar", NUMDIGITS_CPU_NONE   }
+        , { numdigits_count_batch , "count_batch" , NUMDIGITS_CPU_NONE   }
+        , { numdigits_batch_swar  , "batch_swar"  , NUMDIGITS_CPU_NONE   }
+#if NUMDIGITS_X86
+        , { numdigits_batch_sse41 , "batch_sse41" , NUMDIGITS_CPU_SSE41  }
+        , { numdigits_batch_avx2  , "batch_avx2"  , NUMDIGITS_CPU_AVX2   }
+        , { numdigits_batch_fpexp_avx2, "batch_fpexp_avx2", NUMDIGITS_CPU_AVX2 }
+        , { numdigits_batch_avx512, "batch_avx512", NUMDIGITS_CPU_AVX512 }
+#endif
+    };
+    const int nFuncs = sizeof(aFuncs) / sizeof(aFuncs[0]);
+
+    struct FuncDescBatchI64
+    {
+        NumDigitsBatchI64FuncPtr pFunc;
+        const char              *pName;
+        int                      nCPU;
+    };
+
+    FuncDescBatchI64 aFuncsI64[] = {
+          { numdigits_batch_i64_scalar, "batch_i64_scalar", NUMDIGITS_CPU_NONE }
+#if NUMDIGITS_X86
+        , { numdigits_batch_i64_avx2  , "batch_i64_avx2"  , NUMDIGITS_CPU_AVX2 }
+#endif
+    };
+    const int nFuncsI64 = sizeof(aFuncsI64) / sizeof(aFuncsI64[0]);
+
+    struct FuncDescBatchU64
+    {
+        NumDigitsBatchU64FuncPtr pFunc;
+        const char              *pName;
+        int                      nCPU;
+    };
+
+    FuncDescBatchU64 aFuncsU64[] = {
+          { digits10_batch_u64_scalar, "batch_u64_scalar", NUMDIGITS_CPU_NONE }
+#if NUMDIGITS_X86
+        , { digits10_batch_u64_avx2  , "batch_u64_avx2"  , NUMDIGITS_CPU_AVX2 }
+#endif
+        , { digits10_batch_u64_if_sorted, "batch_u64_if_sorted", NUMDIGITS_CPU_NONE }
+    };
+    const int nFuncsU64 = sizeof(aFuncsU64) / sizeof(aFuncsU64[0]);
+
+    struct FuncDescReduce
+    {
+        NumDigitsReduceFuncPtr pFunc;
+        const char            *pName;
+        int                    nCPU;
+    };
+
+    FuncDescReduce aFuncsReduce[] = {
+          { numdigits_reduce_scalar, "reduce_scalar", NUMDIGITS_CPU_NONE }
+        , { numdigits_count_reduce , "count_reduce" , NUMDIGITS_CPU_NONE }
+#if NUMDIGITS_X86
+        , { numdigits_reduce_avx2  , "reduce_avx2"  , NUMDIGITS_CPU_AVX2 }
+#endif
+    };
+    const int nFuncsReduce = sizeof(aFuncsReduce) / sizeof(aFuncsReduce[0]);
+
+    struct FuncDescReduceI64
+    {
+        NumDigitsReduceI64FuncPtr pFunc;
+        const char               *pName;
+        int                       nCPU;
+    };
+
+    FuncDescReduceI64 aFuncsReduceI64[] = {
+          { numdigits_reduce_i64_scalar, "reduce_i64_scalar", NUMDIGITS_CPU_NONE }
+        , { numdigits_count_reduce_i64 , "count_reduce_i64" , NUMDIGITS_CPU_NONE }
+#if NUMDIGITS_X86
+        , { numdigits_reduce_i64_avx2  , "reduce_i64_avx2"  , NUMDIGITS_CPU_AVX2 }
+#endif
+    };
+    const int nFuncsReduceI64 = sizeof(aFuncsReduceI64) / sizeof(aFuncsReduceI64[0]);
+
+    const int nCPU = cpu_features();
+
+    if (g_bCategoryPrint) {
+        printf( "Available tests for '-%s' (%d):\n", CATEGORY, nFuncs + nFuncsI64 + nFuncsU64 + nFuncsReduce + nFuncsReduceI64 + 3 );
+        for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
+            const char *pNextTestName = aFuncs[ iFunc ].pName;
+            printf( "    %s\n", pNextTestName );
+        }
+        for (int iFunc = 0; iFunc < nFuncsI64; iFunc++) {
+            const char *pNextTestName = aFuncsI64[ iFunc ].pName;
+            printf( "    %s\n", pNextTestName );
+        }
+        for (int iFunc = 0; iFunc < nFuncsU64; iFunc++) {
+            const char *pNextTestName = aFuncsU64[ iFunc ].pName;
+            printf( "    %s\n", pNextTestName );
+        }
+        for (int iFunc = 0; iFunc < nFuncsReduce; iFunc++) {
+            const char *pNextTestName = aFuncsReduce[ iFunc ].pName;
+            printf( "    %s\n", pNextTestName );
+        }
+        for (int iFunc = 0; iFunc < nFuncsReduceI64; iFunc++) {
+            const char *pNextTestName = aFuncsReduceI64[ iFunc ].pName;
+            printf( "    %s\n", pNextTestName );
+        }
+        printf( "    %s\n", "parallel_stats" );
+        printf( "    %s\n", "swar_u32x2" );
+        printf( "    %s\n", "sorted" );
+    }
+
+    // The SIMD kernels are always compiled on x86 but we can only run them if the CPU supports them
+    printf( "----------------------------------------\n\n" );
+    for (int iFunc = 0; iFunc < nFuncs; iFunc++) {
+        const char *pNextTestName = aFuncs[ iFunc ].pName;
+        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
+        if (bRunTest) {
+            printf( "\n========== %s (%s) ==========\n", pNextTestName, CATEGORY );
+            if ((aFuncs[ iFunc ].nCPU & nCPU) != aFuncs[ iFunc ].nCPU)
+                printf( "SKIP unsupported CPU\n" );
+            else
+                test_batch( aFuncs[ iFunc ].pFunc );
+        }
+    }
+    for (int iFunc = 0; iFunc < nFuncsI64; iFunc++) {
+        const char *pNextTestName = aFuncsI64[ iFunc ].pName;
+        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
+        if (bRunTest) {
+            printf( "\n========== %s (%s) ==========\n", pNextTestName, CATEGORY );
+            if ((aFuncsI64[ iFunc ].nCPU & nCPU) != aFuncsI64[ iFunc ].nCPU)
+                printf( "SKIP unsupported CPU\n" );
+            else
+                test_batch_i64( aFuncsI64[ iFunc ].pFunc );
+        }
+    }
+    for (int iFunc = 0; iFunc < nFuncsU64; iFunc++) {
+        const char *pNextTestName = aFuncsU64[ iFunc ].pName;
+        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
+        if (bRunTest) {
+            printf( "\n========== %s (%s) ==========\n", pNextTestName, CATEGORY );
+            if ((aFuncsU64[ iFunc ].nCPU & nCPU) != aFuncsU64[ iFunc ].nCPU)
+                printf( "SKIP unsupported CPU\n" );
+            else
+                test_batch_u64( aFuncsU64[ iFunc ].pFunc );
+        }
+    }
+    for (int iFunc = 0; iFunc < nFuncsReduce; iFunc++) {
+        const char *pNextTestName = aFuncsReduce[ iFunc ].pName;
+        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
+        if (bRunTest) {
+            printf( "\n========== %s (%s) ==========\n", pNextTestName, CATEGORY );
+            if ((aFuncsReduce[ iFunc ].nCPU & nCPU) != aFuncsReduce[ iFunc ].nCPU)
+                printf( "SKIP unsupported CPU\n" );
+            else
+                test_reduce<int32_t>( aFuncsReduce[ iFunc ].pFunc, numdigits10_int32 );
+        }
+    }
+    for (int iFunc = 0; iFunc < nFuncsReduceI64; iFunc++) {
+        const char *pNextTestName = aFuncsReduceI64[ iFunc ].pName;
+        bool bRunTest = isTestIncluded( g_pCategoryInclude, pNextTestName );
+        if (bRunTest) {
+            printf( "\n========== %s (%s) ==========\n", pNextTestName, CATEGORY );
+            if ((aFuncsReduceI64[ iFunc ].nCPU & nCPU) != aFuncsReduceI64[ iFunc ].nCPU)
+                printf( "SKIP unsupported CPU\n" );
+            else
+                test_reduce<int64_t>( aFuncsReduceI64[ iFunc ].pFunc, numdigits10_int64 );
+        }
+    }
+    if (isTestIncluded( g_pCategoryInclude, "parallel_stats" )) {
+        printf( "\n========== %s (%s) ==========\n", "parallel_stats", CATEGORY );
+        test_parallel_stats();
+    }
+    if (isTestIncluded( g_pCategoryInclude, "swar_u32x2" )) {
+        printf( "\n========== %s (%s) ==========\n", "swar_u32x2", CATEGORY );
+        test_swar_u32x2();
+    }
+    if (isTestIncluded( g_pCategoryInclude, "sorted" )) {
+        printf( "\n========== %s (%s) ==========\n", "sorted", CATEGORY );
+        test_sorted();
+    }
     printf( "\n" );
 }
 
@@ -883,6 +2811,12 @@ Examples:
     -i64
     -u64
     -org
+    -batch
+    -128
+    -big
+    -write
+    -radix
+    -float
 */
 // ========================================
 int main( int nArg, char *aArg[] )
@@ -893,12 +2827,19 @@ int main( int nArg, char *aArg[] )
     printf( "    sizeof(long long) = %zu bytes\n", sizeof(long long) );
     printf( "    sizeof( int64_t ) = %zu bytes\n", sizeof( int64_t ) );
     printf( "    sizeof(uint64_t ) = %zu bytes\n", sizeof(uint64_t ) );
+    printf( "    numdigits_count   = %s (scalar / batch / reduce)\n", numdigits_count_variant() );
     printf( "----------------------------------------\n" );
 
     initialize( nArg, aArg );
     if (g_bCategoryTests & CATEGORY_INT) verify_int();
     if (g_bCategoryTests & CATEGORY_I64) verify_i64();
     if (g_bCategoryTests & CATEGORY_U64) verify_u64();
+    if (g_bCategoryTests & CATEGORY_BATCH) verify_batch();
+    if (g_bCategoryTests & CATEGORY_128) verify_128();
+    if (g_bCategoryTests & CATEGORY_BIG) verify_bigint();
+    if (g_bCategoryTests & CATEGORY_WRITE) verify_write();
+    if (g_bCategoryTests & CATEGORY_RADIX) verify_radix();
+    if (g_bCategoryTests & CATEGORY_FLOAT) verify_float();
     if (g_bCategoryTests & CATEGORY_ORG) test_original_digits10();
 
     printf( "\nDone.\n" );